@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+/**
+ * @brief Sistema di job con work stealing, condiviso da tutto il motore.
+ *
+ * All'avvio vengono creati `workerCount - 1` thread: il thread principale è il worker 0
+ * e partecipa all'esecuzione mentre attende. Ogni worker ha una propria coda:
+ *  - i job inviati da un thread finiscono nella coda di quel thread;
+ *  - un worker preleva dalla coda propria (LIFO, dati ancora in cache) e, se è vuota,
+ *    ruba dalla testa delle code degli altri (FIFO, blocchi più grandi e più vecchi).
+ *
+ * L'interfaccia è statica come quella dei manager (MeshManager, ShaderManager).
+ * Se il sistema non è inizializzato, parallelFor e dispatch eseguono tutto sul thread chiamante.
+ */
+class JobSystem {
+public:
+    /**
+     * @brief Funzione eseguita su un intervallo [begin, end).
+     * @param begin Primo indice dell'intervallo
+     * @param end Indice successivo all'ultimo
+     * @param workerIndex Indice del worker che esegue (0 = thread principale)
+     */
+    using RangeFunction = std::function<void(size_t begin, size_t end, unsigned workerIndex)>;
+
+    /// Lavoro inviato con dispatch() e non ancora atteso
+    struct Batch;
+    using BatchHandle = std::shared_ptr<Batch>;
+
+    /**
+     * @brief Avvia i thread di lavoro.
+     * @param workerCount Worker totali, thread principale incluso (0 = numero di core)
+     */
+    static void init(unsigned workerCount = 0);
+
+    /// Ferma e unisce i thread di lavoro (chiamata anche da init() se già avviato)
+    static void shutdown();
+
+    /// Numero di worker, thread principale incluso (1 se non inizializzato)
+    static unsigned getWorkerCount();
+
+    /// Indice del worker corrente (0 per il thread principale o thread esterni)
+    static unsigned getCurrentWorkerIndex();
+
+    /**
+     * @brief Esegue `function` su [0, count) suddividendo l'intervallo in blocchi di `grainSize`.
+     *
+     * È bloccante: ritorna quando tutti i blocchi sono stati eseguiti. Mentre attende,
+     * il thread chiamante esegue anch'esso dei blocchi. Con un solo blocco, o senza
+     * worker, l'esecuzione avviene direttamente sul thread chiamante.
+     *
+     * @param count Numero di elementi
+     * @param grainSize Elementi minimi per blocco
+     * @param function Funzione da eseguire per ogni blocco
+     */
+    static void parallelFor(size_t count, size_t grainSize, const RangeFunction& function);
+
+    /**
+     * @brief Come parallelFor, ma ritorna subito: i blocchi vengono eseguiti dai worker
+     * mentre il chiamante prosegue.
+     *
+     * Ogni handle va atteso con wait() prima di shutdown() e prima che i dati usati
+     * da `function` vengano distrutti. Senza worker il lavoro viene svolto qui.
+     *
+     * @return Handle da passare a isDone() e wait()
+     */
+    static BatchHandle dispatch(size_t count, size_t grainSize, RangeFunction function);
+
+    /// Vero se tutti i blocchi del lavoro sono stati eseguiti (handle vuoto = completato)
+    static bool isDone(const BatchHandle& batch);
+
+    /// Attende il lavoro eseguendo blocchi sul thread chiamante nel frattempo
+    static void wait(const BatchHandle& batch);
+};
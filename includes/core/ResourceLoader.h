@@ -1,111 +1,193 @@
-#pragma once
-#include <vector>
-#include <memory>
-#include <string>
-#include <glm/glm.hpp>
-
-#include "graphics/ShaderManager.h"
-#include "graphics/MeshManager.h"
-#include "math/HermiteMesh.h"
-#include "core/PlayerConfig.h"
-#include "core/BackGround.h"
-#include "utilities/Utilities.h"
-
-/**
- * @class ResourceLoader
- * @brief Classe responsabile del caricamento di tutte le risorse di gioco
- * 
- * Centralizza il caricamento di:
- * - Shader (default, background)
- * - Mesh (player, proiettili, UI, background)
- * - Configurazioni (modelli navicelle, sfondi animati)
- * 
- * Pattern utilizzato: Facade
- * - Espone un'interfaccia semplice (loadAllResources)
- * - Delega a metodi privati specializzati
- */
-class ResourceLoader {
-public:
-    // Costruttore e distruttore di default
-    ResourceLoader() = default;
-    ~ResourceLoader() = default;
-
-    /**
-     * @brief Carica TUTTE le risorse di gioco in una singola chiamata
-     * 
-     * Questa funzione è il punto di ingresso principale e orchestra
-     * il caricamento di tutte le risorse necessarie al gioco.
-     * 
-     * @param[out] defaultShaderId ID dello shader di default per il rendering
-     * @param[out] projectileMeshId ID della mesh dei proiettili
-     * @param[out] heartMeshId ID della mesh dei cuori (UI salute)
-     * @param[out] backgroundMeshId ID della mesh quad per lo sfondo
-     * @param[out] playerConfigs Vettore delle configurazioni delle navicelle
-     * @param[out] backgroundConfigs Vettore delle configurazioni degli sfondi
-     * 
-     * @note L'ordine di caricamento è importante:
-     *       1. Default shader (necessario per player configs)
-     *       2. Game meshes (geometrie base)
-     *       3. Player configs (richiedono default shader)
-     *       4. Background configs (richiedono background mesh)
-     */
-    void loadAllResources(
-        unsigned int& defaultShaderId,
-        unsigned int& projectileMeshId,
-        unsigned int& heartMeshId,
-        unsigned int& backgroundMeshId,
-        std::vector<PlayerConfig>& playerConfigs,
-        std::vector<BackgroundConfig>& backgroundConfigs
-    );
-
-private:
-    // FUNZIONI DI CARICAMENTO SPECIALIZZATE
-
-    /**
-     * @brief Carica lo shader di default usato per il rendering standard
-     * @return ID dello shader caricato
-     * 
-     * Legge vertex.glsl e fragment.glsl e li compila in un programma shader.
-     */
-    unsigned int loadDefaultShader();
-    
-    /**
-     * @brief Carica tutte le configurazioni delle navicelle giocabili
-     * @param[out] playerConfigs Vettore da riempire con le configurazioni
-     * @param[in] defaultShaderId Shader da usare per il rendering delle navi
-     * 
-     * Carica 3 modelli di navicella (SW, X-Wing, BaseShip), ciascuno con:
-     * - Base (struttura principale)
-     * - Livery (decorazione)
-     * - Cockpit (cabina)
-     */
-    void loadPlayerConfigs(std::vector<PlayerConfig>& playerConfigs, unsigned int defaultShaderId);
-    
-    /**
-     * @brief Carica le mesh di gioco (non-player)
-     * @param[out] projectileMeshId Mesh del proiettile (rombo)
-     * @param[out] heartMeshId Mesh del cuore per UI salute
-     * @param[out] backgroundMeshId Mesh quad per lo sfondo
-     * 
-     * Utilizza curve di Hermite per generare forme procedurali.
-     */
-    void loadGameMeshes(unsigned int& projectileMeshId, unsigned int& heartMeshId, unsigned int& backgroundMeshId);
-    
-    /**
-     * @brief Carica le configurazioni degli sfondi animati
-     * @param[out] backgroundConfigs Vettore delle configurazioni background
-     * @param[in] backgroundMeshId Mesh quad su cui applicare gli shader
-     * 
-     * Pre-compila tutti gli shader di background disponibili.
-     */
-    void loadBackgrounds(std::vector<BackgroundConfig>& backgroundConfigs, unsigned int& backgroundMeshId);
-
-    /**
-     * @brief Utility per leggere il contenuto di un file shader
-     * @param path Percorso del file GLSL
-     * @return Contenuto del file come stringa
-     * 
-     * Wrapper attorno alla funzione readFile() delle utilities.
-     */
-    std::string readShaderFile(const std::string& path);
-};
+#pragma once
+#include <vector>
+#include <memory>
+#include <string>
+#include <glm/glm.hpp>
+
+#include "graphics/ShaderManager.h"
+#include "graphics/MeshManager.h"
+#include "math/HermiteMesh.h"
+#include "core/PlayerConfig.h"
+#include "core/BackGround.h"
+#include "core/JobSystem.h"
+#include "utilities/Utilities.h"
+
+/**
+ * @class ResourceLoader
+ * @brief Classe responsabile del caricamento di tutte le risorse di gioco
+ * 
+ * Centralizza il caricamento di:
+ * - Shader (default, background)
+ * - Mesh (player, proiettili, UI, background)
+ * - Configurazioni (modelli navicelle, sfondi animati)
+ * 
+ * Pattern utilizzato: Facade
+ * - Espone un'interfaccia semplice (loadAllResources)
+ * - Delega a metodi privati specializzati
+ *
+ * La tassellazione delle navicelle non richiede OpenGL: beginPlayerMeshes() la avvia
+ * sui worker del JobSystem prima ancora che esista la finestra, loadAllResources()
+ * ne attende l'esito e carica le mesh su GPU dal thread principale.
+ * Al caricamento si attende solo la nave selezionata; le altre arrivano su GPU
+ * alla prima selezione tramite preparePlayerMeshes(), per questo il loader resta
+ * in vita per tutta la durata dell'Engine.
+ */
+class ResourceLoader {
+public:
+    ResourceLoader();
+
+    /// Attende l'eventuale tassellazione ancora in corso (i worker scrivono nei membri)
+    ~ResourceLoader();
+
+    ResourceLoader(const ResourceLoader&) = delete;
+    ResourceLoader& operator=(const ResourceLoader&) = delete;
+
+    /**
+     * @brief Avvia in background la fase CPU delle mesh di un modello di navicella
+     *
+     * Lettura dei file, curve TBC e triangolazione di ogni layer, un job per layer.
+     * Non usa OpenGL: può essere chiamata prima della creazione della finestra.
+     * Non fa nulla se il modello è già avviato o caricato.
+     *
+     * @param modelIndex Indice del modello, nell'ordine di playerConfigs
+     */
+    void beginPlayerMeshes(unsigned int modelIndex);
+
+    /**
+     * @brief Rende disponibili su GPU le mesh di un modello e ne scrive gli ID nella configurazione
+     *
+     * Avvia la tassellazione se non è ancora partita. Va chiamata sul thread del contesto OpenGL.
+     *
+     * @param[in,out] config Configurazione del modello (riceve gli ID delle mesh)
+     * @param modelIndex Indice del modello, nell'ordine di playerConfigs
+     * @param wait Se true attende la tassellazione invece di ritornare subito
+     * @return true se le mesh sono caricate, false se la tassellazione è ancora in corso
+     */
+    bool preparePlayerMeshes(PlayerConfig& config, unsigned int modelIndex, bool wait);
+
+    /**
+     * @brief Carica TUTTE le risorse di gioco in una singola chiamata
+     * 
+     * Questa funzione è il punto di ingresso principale e orchestra
+     * il caricamento di tutte le risorse necessarie al gioco.
+     * 
+     * @param[out] defaultShaderId ID dello shader di default per il rendering
+     * @param[out] instancedShaderId ID della variante instanced dello shader di default
+     * @param[out] projectileMeshId ID della mesh dei proiettili
+     * @param[out] heartMeshId ID della mesh dei cuori (UI salute)
+     * @param[out] backgroundMeshId ID della mesh quad per lo sfondo
+     * @param[out] playerConfigs Vettore delle configurazioni delle navicelle
+     * @param[out] backgroundConfigs Vettore delle configurazioni degli sfondi
+     * @param[in] selectedPlayerConfig Nave mostrata al primo frame, l'unica caricata subito
+     * 
+     * @note L'ordine di caricamento è importante:
+     *       1. Shader di default e di background (solo accodati)
+     *       2. Game meshes (geometrie base, generate mentre il driver compila)
+     *       3. Player configs (richiedono l'ID del default shader)
+     *       4. Esito di compilazione e link
+     *       5. Warm-up degli shader (richiede la background mesh e il blocco FrameData collegato)
+     */
+    void loadAllResources(
+        unsigned int& defaultShaderId,
+        unsigned int& instancedShaderId,
+        unsigned int& projectileMeshId,
+        unsigned int& heartMeshId,
+        unsigned int& backgroundMeshId,
+        std::vector<PlayerConfig>& playerConfigs,
+        std::vector<BackgroundConfig>& backgroundConfigs,
+        unsigned int selectedPlayerConfig
+    );
+
+private:
+    // FUNZIONI DI CARICAMENTO SPECIALIZZATE
+
+    /**
+     * @brief Carica lo shader di default usato per il rendering standard
+     * @return ID dello shader caricato
+     * 
+     * Legge vertex.glsl e fragment.glsl e li compila in un programma shader.
+     */
+    unsigned int loadDefaultShader();
+
+    /**
+     * @brief Carica la variante instanced dello shader di default
+     * @return ID dello shader caricato
+     *
+     * Legge vertex_instanced.glsl e fragment_instanced.glsl: trasformazione e colore
+     * arrivano dagli attributi per istanza invece che dalle uniform.
+     */
+    unsigned int loadInstancedShader();
+
+    /**
+     * @brief Carica lo shader usato da DebugDraw ("DebugLineShader")
+     * @return ID dello shader caricato
+     *
+     * Legge debug_vertex.glsl e riusa fragment_instanced.glsl (colore per vertice).
+     */
+    unsigned int loadDebugLineShader();
+    
+    /**
+     * @brief Carica tutte le configurazioni delle navicelle giocabili
+     * @param[out] playerConfigs Vettore da riempire con le configurazioni
+     * @param[in] defaultShaderId Shader da usare per il rendering delle navi
+     * @param[in] selectedConfig Modello caricato subito su GPU
+     * @param[in] lazyShips Se false carica subito anche tutti gli altri modelli
+     * 
+     * Carica 3 modelli di navicella (SW, X-Wing, BaseShip), ciascuno con:
+     * - Base (struttura principale)
+     * - Livery (decorazione)
+     * - Cockpit (cabina)
+     *
+     * Attende la tassellazione del modello selezionato e ne carica i layer su GPU;
+     * gli altri restano in tassellazione sui worker.
+     */
+    void loadPlayerConfigs(std::vector<PlayerConfig>& playerConfigs, unsigned int defaultShaderId,
+        unsigned int selectedConfig, bool lazyShips);
+    
+    /**
+     * @brief Carica le mesh di gioco (non-player)
+     * @param[out] projectileMeshId Mesh del proiettile (rombo)
+     * @param[out] heartMeshId Mesh del cuore per UI salute
+     * @param[out] backgroundMeshId Mesh quad per lo sfondo
+     * 
+     * Utilizza curve di Hermite per generare forme procedurali.
+     */
+    void loadGameMeshes(unsigned int& projectileMeshId, unsigned int& heartMeshId, unsigned int& backgroundMeshId);
+    
+    /**
+     * @brief Carica le configurazioni degli sfondi animati
+     * @param[out] backgroundConfigs Vettore delle configurazioni background
+     * @param[in] backgroundMeshId Mesh quad su cui applicare gli shader
+     * 
+     * Pre-compila tutti gli shader di background disponibili.
+     */
+    void loadBackgrounds(std::vector<BackgroundConfig>& backgroundConfigs, unsigned int& backgroundMeshId);
+
+    /**
+     * @brief Utility per leggere il contenuto di un file shader
+     * @param path Percorso del file GLSL
+     * @return Contenuto del file come stringa
+     * 
+     * Wrapper attorno alla funzione readFile() delle utilities.
+     */
+    std::string readShaderFile(const std::string& path);
+
+    /**
+     * @brief Esegue un disegno invisibile con ogni shader registrato
+     * @param meshId Mesh usata per il disegno (il quad dello sfondo)
+     */
+    void warmUpShaders(unsigned int meshId);
+
+    // STATO DELLA TASSELLAZIONE IN BACKGROUND
+
+    /// Stato di caricamento dei layer di un modello di navicella
+    struct ShipModelMeshes {
+        std::vector<CurveMeshData> layers;  ///< Geometria di ogni layer, scritta dai worker
+        std::vector<char> valid;            ///< Esito della tassellazione per layer
+        std::vector<double> layerMs;        ///< Tempo CPU speso per layer (ms)
+        JobSystem::BatchHandle jobs;        ///< Tassellazione avviata (vuoto se non avviata o caricata)
+        bool uploaded = false;              ///< Mesh registrate nel MeshManager
+    };
+
+    std::vector<ShipModelMeshes> shipModels; ///< Un elemento per modello, dimensionato nel costruttore
+};
@@ -1,47 +1,70 @@
-#pragma once
-#include <glm/glm.hpp>
-#include "graphics/Mesh.h"
-
-// Implementazione Axis-Aligned Bounding Box (AABB) per il rilevamento delle collisioni
-
-/**
-* @brief Struttura Axis-Aligned Bounding Box (AABB)
- * Rappresenta un rettangolo allineato agli assi per il rilevamento delle collisioni 2D.
- * @param min Punto minimo (angolo in basso a sinistra)
- * @param max Punto massimo (angolo in alto a destra)
- */
-struct AABB {
-    glm::vec2 min;
-    glm::vec2 max;
-
-    /**
-	* @brief Costruttore di default che inizializza l'AABB a valori estremi.
-    */
-    AABB()
-        : min(std::numeric_limits<float>::max()),
-        max(std::numeric_limits<float>::lowest()) {
-    }   
-
-    /**
-	* @brief Costruttore che inizializza l'AABB con i punti minimi e massimi specificati.
-	* Viene utilizzata per le entit con bounding box predefinite.
-    */
-    AABB(const glm::vec2& minPt, const glm::vec2& maxPt)
-        : min(minPt), max(maxPt) {
-    }
-
-    /**
-	* @brief Controlla se questa AABB collide con un'altra AABB.
-    */
-    bool isColliding(const AABB& other) const {
-        return (min.x <= other.max.x && max.x >= other.min.x &&
-            min.y <= other.max.y && max.y >= other.min.y);
-    }
-};
-
-/**
-* @brief Calcola l'AABB di una mesh trasformata.
-* @param mesh Puntatore condiviso alla mesh
-* @param transformMatrix Matrice di trasformazione da applicare alla mesh
-*/
-AABB calculateMeshAABB(const std::shared_ptr<Mesh>& mesh, const glm::mat4& transformMatrix);
\ No newline at end of file
+#pragma once
+#include <glm/glm.hpp>
+#include "graphics/Mesh.h"
+#include "math/Affine2D.h"
+
+// Implementazione Axis-Aligned Bounding Box (AABB) per il rilevamento delle collisioni
+
+/**
+* @brief Struttura Axis-Aligned Bounding Box (AABB)
+ * Rappresenta un rettangolo allineato agli assi per il rilevamento delle collisioni 2D.
+ * @param min Punto minimo (angolo in basso a sinistra)
+ * @param max Punto massimo (angolo in alto a destra)
+ */
+struct AABB {
+    glm::vec2 min;
+    glm::vec2 max;
+
+    /**
+	* @brief Costruttore di default che inizializza l'AABB a valori estremi.
+    */
+    AABB()
+        : min(std::numeric_limits<float>::max()),
+        max(std::numeric_limits<float>::lowest()) {
+    }   
+
+    /**
+	* @brief Costruttore che inizializza l'AABB con i punti minimi e massimi specificati.
+	* Viene utilizzata per le entità con bounding box predefinite.
+    */
+    AABB(const glm::vec2& minPt, const glm::vec2& maxPt)
+        : min(minPt), max(maxPt) {
+    }
+
+    /**
+	* @brief Controlla se questa AABB collide con un'altra AABB.
+    */
+    bool isColliding(const AABB& other) const {
+        return (min.x <= other.max.x && max.x >= other.min.x &&
+            min.y <= other.max.y && max.y >= other.min.y);
+    }
+
+    /**
+	* @brief Restituisce true se l'AABB contiene almeno un punto (min <= max).
+    */
+    bool isValid() const {
+        return min.x <= max.x && min.y <= max.y;
+    }
+
+    /**
+	* @brief Espande l'AABB per includere un'altra AABB.
+    */
+    void expand(const AABB& other) {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+};
+
+/**
+* @brief Calcola l'AABB di una mesh trasformata.
+*
+* Usa i bound locali memorizzati nella mesh: si trasforma il centro dell'AABB locale e
+* si proietta la semi-estensione con il valore assoluto della parte lineare (equivale a
+* trasformare i quattro angoli), quindi il costo è O(1) indipendentemente dal numero di vertici.
+* Il risultato è conservativo (può essere leggermente più grande dell'AABB esatta
+* quando la mesh è ruotata).
+*
+* @param mesh Mesh di cui calcolare l'ingombro
+* @param transform Trasformazione affine 2D da applicare alla mesh
+*/
+AABB calculateMeshAABB(const Mesh& mesh, const Affine2D& transform);
\ No newline at end of file
@@ -1,175 +1,287 @@
-#pragma once
-#include <string>
-#include <memory>
-#include <vector>
-#include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-#include "game/Collision.h"
-
-// Forward declarations per ridurre le dipendenze circolari
-class Entity;
-
-/**
- * @brief Contiene informazioni di rendering per una sotto-mesh (SubMesh)
- *
- * Ogni entit pu avere pi SubMesh da renderizzare, ciascuna con un proprio
- * shader, colore e trasformazione locale.
- */
-struct SubMeshRenderInfo {
-    unsigned int meshId;                 ///< Identificativo della mesh (gestito dal MeshManager)
-    unsigned int shaderId;               ///< Identificativo dello shader da usare per il rendering
-    glm::vec4 color;                     ///< Colore della mesh (RGBA)
-    bool visible = true;                 ///< Indica se la mesh  visibile
-    glm::mat4 localTransform = glm::mat4(1.0f); ///< Trasformazione locale della SubMesh
-
-    /**
-     * @brief Costruttore base per una SubMesh.
-     * @param mId ID della mesh
-     * @param sId ID dello shader
-     * @param col Colore iniziale
-     */
-    SubMeshRenderInfo(unsigned int mId, unsigned int sId, const glm::vec4& col)
-        : meshId(mId), shaderId(sId), color(col) {
-    }
-};
-
-/**
- * @brief Classe base per tutti i componenti di un'entit.
- *
- * Tutti i componenti derivano da questa classe e possiedono un riferimento
- * al proprietario (`Entity`) e un flag di abilitazione.
- */
-class Component {
-public:
-    virtual ~Component() = default;
-
-    bool enabled = true;     ///< Indica se il componente  attivo
-    Entity* owner = nullptr; ///< Puntatore all'entit proprietaria
-};
-
-/**
- * @brief Componente che gestisce posizione, rotazione e scala di un'entit.
- *
- * Fornisce metodi per manipolare la trasformazione e calcolare la matrice modello.
- */
-class TransformComponent : public Component {
-private:
-    glm::vec2 position; ///< Posizione 2D dell'entit
-    glm::vec2 scale;    ///< Scala dell'entit
-    float rotation;     ///< Rotazione in radianti
-
-public:
-    /**
-     * @brief Costruttore del TransformComponent.
-     * @param pos Posizione iniziale
-     * @param rot Rotazione iniziale
-     * @param scl Scala iniziale
-     */
-    TransformComponent(
-        const glm::vec2& pos = glm::vec2(0.0f),
-        float rot = 0.0f,
-        const glm::vec2& scl = glm::vec2(1.0f)
-    ) : position(pos), rotation(rot), scale(scl) {
-    }
-
-    ~TransformComponent() override = default;
-
-    /**
-     * @brief Restituisce la matrice modello (Model Matrix) calcolata da posizione, rotazione e scala.
-     */
-    const glm::mat4 getModelMatrix() const;
-
-    // Getters
-    const glm::vec2& getPosition() const { return position; }
-    float getRotation() const { return rotation; }
-    const glm::vec2& getScale() const { return scale; }
-
-    // Setters
-    void setPosition(const glm::vec2& pos);
-    void setRotation(float rot);
-    void setScale(const glm::vec2& scl);
-
-    // Utility methods
-    void translate(const glm::vec2& offset);
-    void rotate(float angle);
-    void scaleBy(const glm::vec2& factor);
-};
-
-/**
- * @brief Componente responsabile della gestione del rendering di un'entit.
- *
- * Contiene una lista di SubMeshRenderInfo che specificano le varie mesh e shader da renderizzare.
- */
-class RenderComponent : public Component {
-private:
-    std::vector<SubMeshRenderInfo> subMeshes; ///< Lista delle sotto-mesh da disegnare
-
-public:
-    RenderComponent() = default;
-    ~RenderComponent() override = default;
-
-    /**
-     * @brief Aggiunge una SubMesh da renderizzare.
-     * @param meshInfo Riferimento alle informazioni della SubMesh
-     */
-    void addSubMesh(SubMeshRenderInfo& meshInfo);
-
-    /**
-     * @brief Restituisce l'elenco completo delle SubMesh.
-     */
-    const std::vector<SubMeshRenderInfo>& getSubMeshes() const;
-
-    /**
-     * @brief Rimuove tutte le SubMesh registrate.
-     */
-    void clearSubMesh();
-};
-
-/**
- * @brief Classe base per tutte le entit del gioco (giocatore, nemici, proiettili, ecc.)
- *
- * Ogni entit possiede un identificativo unico, un nome, e una serie di componenti.
- * La classe  astratta e deve essere derivata per implementare il comportamento (`update`).
- */
-class Entity {
-private:
-    static int nextId;  ///< Contatore statico per assegnare ID univoci
-    int id;             ///< Identificativo dell'entit
-    std::string name;   ///< Nome leggibile dell'entit
-    bool active;        ///< Stato di attivazione
-
-public:
-    // Componenti principali (composition-based)
-    TransformComponent transform;  ///< Gestisce posizione, rotazione e scala
-    RenderComponent renderData;    ///< Contiene le informazioni di rendering
-
-    // Costruttori e distruttori
-    explicit Entity(const std::string& entityName = "Entity");
-    virtual ~Entity() = default;
-
-    // Evita copia per mantenere unicit dell'entit
-    Entity(const Entity&) = delete;
-    Entity& operator=(const Entity&) = delete;
-
-    // Abilita lo spostamento (move semantics)
-    Entity(Entity&&) = default;
-    Entity& operator=(Entity&&) = default;
-
-    // Gestione rendering
-    void addMeshLayer(SubMeshRenderInfo meshInfo);
-    void clearMeshLayers();
-
-    // Metodi virtuali base
-    virtual void update(float deltaTime) = 0;   ///< Aggiorna lo stato logico dell'entit
-    virtual void onCollision(Entity* other) {}  ///< Gestisce eventuali collisioni
-    virtual AABB getAABB() const;               ///< Restituisce il bounding box dell'entit
-
-    // Getter e Setter
-    int getId() const { return id; }
-    const std::string& getName() const { return name; }
-    bool isActive() const { return active; }
-    TransformComponent getTransform() const { return transform; }
-
-    void setActive(bool state) { active = state; }
-    void setName(const std::string& newName) { name = newName; }
-};
+#pragma once
+#include <string>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include "game/Collision.h"
+#include "math/Affine2D.h"
+#include "scene/EntityHandle.h"
+
+// Forward declarations per ridurre le dipendenze circolari
+class Entity;
+class Scene;
+
+/**
+ * @brief Categoria di un'entità, usata dalla Scene per smistarla nel bucket corretto.
+ *
+ * Sostituisce i controlli a runtime (dynamic_cast, confronto dei nomi): ogni classe
+ * derivata dichiara il proprio tipo nel costruttore.
+ */
+enum class EntityKind : uint8_t {
+    Generic,     ///< Entità senza un comportamento specifico
+    Player,      ///< Navicella del giocatore
+    Projectile,  ///< Proiettili
+    Obstacle,    ///< Asteroidi e comete
+    Count        ///< Numero di categorie (non è un tipo valido)
+};
+
+/**
+ * @brief Layer di collisione (bitfield).
+ *
+ * Ogni entità appartiene a un layer (`collisionLayer`) e dichiara con quali layer
+ * può collidere (`collisionMask`). Due entità vengono testate solo se
+ * `a.mask & b.layer` è diverso da zero.
+ */
+namespace CollisionLayer {
+    constexpr uint32_t None = 0;
+    constexpr uint32_t Player = 1u << 0;
+    constexpr uint32_t Projectile = 1u << 1;
+    constexpr uint32_t Obstacle = 1u << 2;
+}
+
+/**
+ * @brief Contiene informazioni di rendering per una sotto-mesh (SubMesh)
+ *
+ * Ogni entità può avere più SubMesh da renderizzare, ciascuna con un proprio
+ * shader, colore e trasformazione locale.
+ */
+struct SubMeshRenderInfo {
+    unsigned int meshId;                 ///< Identificativo della mesh (gestito dal MeshManager)
+    unsigned int shaderId;               ///< Identificativo dello shader da usare per il rendering
+    glm::vec4 color;                     ///< Colore della mesh (RGBA)
+    bool visible = true;                 ///< Indica se la mesh è visibile
+    Affine2D localTransform;             ///< Trasformazione locale 2D della SubMesh
+    float depth = 0.0f;                  ///< Profondità (Z) del layer, usata solo dagli shader
+
+    /**
+     * @brief Costruttore base per una SubMesh.
+     * @param mId ID della mesh
+     * @param sId ID dello shader
+     * @param col Colore iniziale
+     */
+    SubMeshRenderInfo(unsigned int mId, unsigned int sId, const glm::vec4& col)
+        : meshId(mId), shaderId(sId), color(col) {
+    }
+};
+
+/**
+ * @brief Classe base per tutti i componenti di un'entità.
+ *
+ * Tutti i componenti derivano da questa classe e possiedono un riferimento
+ * al proprietario (`Entity`) e un flag di abilitazione.
+ */
+class Component {
+public:
+    virtual ~Component() = default;
+
+    bool enabled = true;     ///< Indica se il componente è attivo
+    Entity* owner = nullptr; ///< Puntatore all'entità proprietaria
+};
+
+/**
+ * @brief Componente che gestisce posizione, rotazione e scala di un'entità.
+ *
+ * Fornisce metodi per manipolare la trasformazione e calcolare la matrice modello.
+ *
+ * La matrice modello è in cache: i metodi che modificano il transform la marcano come
+ * "dirty" e viene ricostruita solo alla prima getModelMatrix() successiva. Anche seno e
+ * coseno della rotazione sono in cache, quindi uno spostamento non li ricalcola.
+ */
+class TransformComponent : public Component {
+private:
+    glm::vec2 position; ///< Posizione 2D dell'entità
+    glm::vec2 scale;    ///< Scala dell'entità
+    float rotation;     ///< Rotazione in radianti
+
+    // Stato al passo di simulazione precedente (per l'interpolazione nel rendering)
+    glm::vec2 previousPosition = glm::vec2(0.0f);
+    float previousRotation = 0.0f;
+
+    // Cache della matrice modello (ricostruita solo se dirty)
+    mutable Affine2D modelMatrix;
+    mutable bool dirty = true;
+    mutable uint32_t version = 0;       ///< Incrementata a ogni ricostruzione della matrice
+    mutable float cachedAngle = 0.0f;   ///< Angolo a cui si riferiscono cachedSin/cachedCos
+    mutable float cachedSin = 0.0f;
+    mutable float cachedCos = 1.0f;
+
+public:
+    /**
+     * @brief Costruttore del TransformComponent.
+     * @param pos Posizione iniziale
+     * @param rot Rotazione iniziale
+     * @param scl Scala iniziale
+     */
+    TransformComponent(
+        const glm::vec2& pos = glm::vec2(0.0f),
+        float rot = 0.0f,
+        const glm::vec2& scl = glm::vec2(1.0f)
+    ) : position(pos), rotation(rot), scale(scl) {
+    }
+
+    ~TransformComponent() override = default;
+
+    /**
+     * @brief Restituisce la matrice modello (Model Matrix) calcolata da posizione, rotazione e scala.
+     *
+     * È una trasformazione affine 2D (3x2): va espansa in mat4 solo per l'upload agli shader.
+     * Il riferimento resta valido finché il transform non viene modificato.
+     */
+    const Affine2D& getModelMatrix() const;
+
+    /**
+     * @brief Restituisce la versione della matrice modello.
+     *
+     * Cambia ogni volta che la matrice viene ricostruita: permette a chi deriva
+     * altre matrici dal transform di sapere se la propria cache è ancora valida.
+     */
+    uint32_t getVersion() const { getModelMatrix(); return version; }
+
+    /**
+     * @brief Salva posizione e rotazione correnti come stato "precedente".
+     * Va chiamata all'inizio di ogni passo di simulazione.
+     */
+    void storePrevious() { previousPosition = position; previousRotation = rotation; }
+
+    /**
+     * @brief Allinea lo stato precedente a quello corrente (teletrasporto, spawn):
+     * il rendering non interpola dalla posizione vecchia.
+     */
+    void resetInterpolation() { storePrevious(); }
+
+    /// Vero se il transform è cambiato dall'ultimo storePrevious()
+    bool hasMoved() const { return previousPosition != position || previousRotation != rotation; }
+
+    /**
+     * @brief Matrice modello interpolata tra il passo precedente e quello corrente.
+     * @param alpha Frazione di passo in [0, 1] (vedi Timer::getInterpolationAlpha)
+     */
+    Affine2D getInterpolatedMatrix(float alpha) const;
+
+    // Getters
+    const glm::vec2& getPosition() const { return position; }
+    float getRotation() const { return rotation; }
+    const glm::vec2& getScale() const { return scale; }
+
+    // Setters
+    void setPosition(const glm::vec2& pos);
+    void setRotation(float rot);
+    void setScale(const glm::vec2& scl);
+
+    // Utility methods
+    void translate(const glm::vec2& offset);
+    void rotate(float angle);
+    void scaleBy(const glm::vec2& factor);
+};
+
+/**
+ * @brief Componente responsabile della gestione del rendering di un'entità.
+ *
+ * Contiene una lista di SubMeshRenderInfo che specificano le varie mesh e shader da renderizzare.
+ */
+class RenderComponent : public Component {
+private:
+    std::vector<SubMeshRenderInfo> subMeshes; ///< Lista delle sotto-mesh da disegnare
+
+public:
+    RenderComponent() = default;
+    ~RenderComponent() override = default;
+
+    /**
+     * @brief Aggiunge una SubMesh da renderizzare.
+     * @param meshInfo Riferimento alle informazioni della SubMesh
+     */
+    void addSubMesh(SubMeshRenderInfo& meshInfo);
+
+    /**
+     * @brief Restituisce l'elenco completo delle SubMesh.
+     */
+    const std::vector<SubMeshRenderInfo>& getSubMeshes() const;
+
+    /**
+     * @brief Rimuove tutte le SubMesh registrate.
+     */
+    void clearSubMesh();
+};
+
+/**
+ * @brief Classe base per tutte le entità del gioco (giocatore, nemici, proiettili, ecc.)
+ *
+ * Ogni entità possiede un handle (assegnato dalla Scene), un nome, e una serie di componenti.
+ * La classe è astratta e deve essere derivata per implementare il comportamento (`update`).
+ */
+class Entity {
+private:
+    EntityHandle handle; ///< Handle generazionale assegnato dalla Scene
+    std::string name;   ///< Nome leggibile dell'entità
+    bool active;        ///< Stato di attivazione
+
+    // Cache delle matrici mondo delle sub-mesh (entityModel * localTransform)
+    mutable std::vector<Affine2D> subMeshWorld;
+    mutable uint32_t subMeshWorldVersion = 0; ///< Versione del transform usata per la cache
+    mutable bool subMeshWorldValid = false;   ///< Falso dopo aver aggiunto/rimosso layer
+    EntityKind kind;    ///< Categoria dell'entità (bucket nella Scene)
+    AABB worldBounds;   ///< AABB in coordinate mondo, ricalcolata una volta per frame da updateBounds()
+
+    friend class Scene; ///< Solo la Scene assegna e invalida l'handle
+
+public:
+    // Componenti principali (composition-based)
+    TransformComponent transform;  ///< Gestisce posizione, rotazione e scala
+    RenderComponent renderData;    ///< Contiene le informazioni di rendering
+
+    uint32_t collisionLayer = CollisionLayer::None; ///< Layer di appartenenza
+    uint32_t collisionMask = CollisionLayer::None;  ///< Layer con cui l'entità collide
+
+    // Costruttori e distruttori
+    explicit Entity(const std::string& entityName = "Entity", EntityKind entityKind = EntityKind::Generic);
+    virtual ~Entity() = default;
+
+    // Evita copia per mantenere unicità dell'entità
+    Entity(const Entity&) = delete;
+    Entity& operator=(const Entity&) = delete;
+
+    // Abilita lo spostamento (move semantics)
+    Entity(Entity&&) = default;
+    Entity& operator=(Entity&&) = default;
+
+    // Gestione rendering
+    void addMeshLayer(SubMeshRenderInfo meshInfo);
+    void clearMeshLayers();
+
+    // Metodi virtuali base
+    virtual void update(float deltaTime) = 0;   ///< Aggiorna lo stato logico dell'entità
+    virtual void onCollision(Entity* other) {}  ///< Gestisce eventuali collisioni
+    virtual AABB getAABB() const;               ///< Restituisce il bounding box dell'entità (in cache)
+
+    /**
+     * @brief Restituisce le matrici mondo delle sub-mesh (`model * localTransform`).
+     *
+     * Sono nello stesso ordine di `renderData.getSubMeshes()` e vengono ricalcolate
+     * solo se il transform o l'elenco dei layer sono cambiati.
+     */
+    const std::vector<Affine2D>& getSubMeshWorldMatrices() const;
+
+    /**
+     * @brief Ricalcola l'AABB in coordinate mondo a partire dai bound locali delle mesh.
+     *
+     * Va chiamata una volta per frame dopo aver aggiornato il transform (lo fa la Scene):
+     * tutte le query successive (collisioni, debug) leggono il valore in cache.
+     */
+    void updateBounds();
+
+    // Getter e Setter
+    EntityHandle getHandle() const { return handle; }
+    const std::string& getName() const { return name; }
+    bool isActive() const { return active; }
+    EntityKind getKind() const { return kind; }
+    TransformComponent getTransform() const { return transform; }
+
+    void setActive(bool state) { active = state; }
+    void setName(const std::string& newName) { name = newName; }
+
+    /// Vero se questa entità deve essere testata contro `other`
+    bool collidesWith(const Entity& other) const { return (collisionMask & other.collisionLayer) != 0; }
+};
@@ -0,0 +1,80 @@
+#pragma once
+#include <glm/glm.hpp>
+#include "graphics/RenderTarget.h"
+#include "graphics/GpuTimer.h"
+
+/**
+ * @class BackgroundPass
+ * @brief Disegna lo sfondo in un framebuffer a risoluzione ridotta e lo ingrandisce sullo schermo.
+ *
+ * Gli shader di sfondo sono a tutto schermo e costano per pixel: con scala 0.5 il fragment
+ * shader gira su un quarto dei pixel e il blit bilineare riporta l'immagine a piena risoluzione.
+ * Con refreshInterval > 1 lo sfondo viene rigenerato solo ogni N frame e negli altri
+ * si riusa la texture (solo il blit). Cambi di shader o di dimensione forzano la rigenerazione.
+ *
+ * Con scala 1 e intervallo 1 il passo disegna direttamente nella destinazione, senza FBO.
+ * La destinazione è lo schermo oppure il render target della scena (risoluzione dinamica).
+ * Il tempo GPU dell'intero passo (disegno + blit) è misurato con un GpuTimer.
+ *
+ * Uso:
+ * @code
+ * if (pass.begin(w, h, shaderId)) { ...disegna lo sfondo... }
+ * pass.end(output, w, h);
+ * @endcode
+ */
+class BackgroundPass {
+public:
+    static constexpr float MIN_SCALE = 0.25f;
+    static constexpr float MAX_SCALE = 1.0f;
+    static constexpr int MAX_REFRESH_INTERVAL = 8;
+
+    /**
+     * @brief Apre il passo del frame.
+     * @param outputWidth Larghezza della destinazione finale
+     * @param outputHeight Altezza della destinazione finale
+     * @param shaderId Shader di sfondo corrente (un cambio forza la rigenerazione)
+     * @return true se lo sfondo va disegnato ora; la destinazione del disegno è già collegata
+     */
+    bool begin(int outputWidth, int outputHeight, unsigned int shaderId);
+
+    /**
+     * @brief Chiude il passo: ricollega la destinazione e, se si usa l'FBO, esegue il blit bilineare.
+     * @param output Render target della scena (nullptr = schermo)
+     */
+    void end(const RenderTarget* output, int outputWidth, int outputHeight);
+
+    /// Imposta la scala di risoluzione, limitata a [MIN_SCALE, MAX_SCALE]
+    void setScale(float newScale);
+    float getScale() const { return scale; }
+
+    /// Imposta ogni quanti frame rigenerare lo sfondo, limitato a [1, MAX_REFRESH_INTERVAL]
+    void setRefreshInterval(int frames);
+    int getRefreshInterval() const { return refreshInterval; }
+
+    /// Forza la rigenerazione al prossimo begin()
+    void invalidate() { dirty = true; }
+
+    /// Vero se il passo usa il framebuffer ridotto invece di disegnare direttamente
+    bool isOffscreen() const { return scale < MAX_SCALE || refreshInterval > 1; }
+
+    /// Dimensione in pixel della destinazione del disegno dello sfondo
+    glm::ivec2 getTargetSize() const { return targetSize; }
+
+    /// Vero se nell'ultimo frame lo sfondo è stato rigenerato
+    bool wasRefreshed() const { return refreshed; }
+
+    /// Tempo GPU medio del passo in millisecondi
+    float getGpuMilliseconds() const { return gpuTimer.getAverageMilliseconds(); }
+
+private:
+    RenderTarget target;
+    GpuTimer gpuTimer;
+
+    float scale = 0.5f;
+    int refreshInterval = 1;
+    int framesSinceRefresh = 0;
+    unsigned int lastShaderId = 0;
+    glm::ivec2 targetSize = glm::ivec2(0);
+    bool dirty = true;
+    bool refreshed = false;
+};
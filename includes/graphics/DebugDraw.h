@@ -0,0 +1,61 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include "game/Collision.h"
+
+namespace vrtx {
+    class VertexArray;
+    class VertexBuffer;
+}
+
+/**
+ * @class DebugDraw
+ * @brief Accumula le primitive di debug (linee, riquadri, cerchi) e le disegna con una sola chiamata.
+ *
+ * Durante il frame le primitive vengono scomposte in segmenti e aggiunte a un vettore CPU;
+ * flush() le carica in un VBO di streaming persistente (orfanato e ingrandito quando serve)
+ * e le disegna come GL_LINES. VAO e VBO vengono creati al primo flush e riusati tra i frame:
+ * il costo per primitiva è solo quello della scrittura dei vertici.
+ *
+ * Il colore è un attributo per vertice, quindi primitive di colori diversi stanno nella
+ * stessa chiamata. Lo shader ("DebugLineShader") legge la camera dal blocco FrameData.
+ */
+class DebugDraw {
+public:
+    DebugDraw();
+    ~DebugDraw();
+
+    /// Aggiunge un segmento da `a` a `b`
+    void line(const glm::vec2& a, const glm::vec2& b, const glm::vec4& color);
+
+    /// Aggiunge il contorno di un riquadro allineato agli assi (4 segmenti)
+    void box(const AABB& box, const glm::vec4& color);
+
+    /**
+     * @brief Aggiunge il contorno di un cerchio approssimato da un poligono regolare.
+     * @param segments Numero di lati del poligono (almeno 3)
+     */
+    void circle(const glm::vec2& center, float radius, const glm::vec4& color, int segments = 24);
+
+    /**
+     * @brief Carica e disegna tutti i segmenti accumulati, poi svuota il buffer CPU.
+     * @return Numero di chiamate di disegno eseguite (0 se non c'era nulla da disegnare)
+     */
+    unsigned int flush();
+
+    /// Segmenti disegnati dall'ultimo flush()
+    unsigned int getLastLineCount() const { return lastLineCount; }
+
+private:
+    /// Vertice di un segmento: posizione mondo e colore (24 byte)
+    struct LineVertex {
+        glm::vec2 position;
+        glm::vec4 color;
+    };
+
+    std::vector<LineVertex> vertices;           ///< Segmenti del frame, due vertici ciascuno
+    std::unique_ptr<vrtx::VertexArray> vao;     ///< VAO persistente (creato al primo flush)
+    std::unique_ptr<vrtx::VertexBuffer> vbo;    ///< VBO di streaming persistente
+    unsigned int lastLineCount = 0;
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include <glm/glm.hpp>
+#include "graphics/RenderTarget.h"
+#include "graphics/GpuTimer.h"
+
+/**
+ * @class DynamicResolution
+ * @brief Disegna la scena in un render target la cui risoluzione segue un budget di tempo GPU.
+ *
+ * Il tempo GPU del frame (dalla begin() al blit) è misurato con un GpuTimer. Se resta sopra
+ * il budget per SHRINK_FRAMES frame la scala scende di SHRINK_STEP; se resta sotto
+ * budget * GROW_HEADROOM per GROW_FRAMES frame risale di GROW_STEP. L'asimmetria
+ * (scendere subito, risalire piano) evita che la scala oscilli tra due valori.
+ * Dopo ogni cambio si ignorano SETTLE_FRAMES misure, così i risultati ancora in volo
+ * della risoluzione precedente non influenzano la decisione successiva.
+ *
+ * A scala piena (o se disabilitata) la scena va direttamente sullo schermo;
+ * altrimenti end() la riporta alla dimensione della finestra con un blit bilineare.
+ * La proiezione della camera non cambia: la scala è uniforme e l'aspect ratio resta lo stesso.
+ */
+class DynamicResolution {
+public:
+    static constexpr float MIN_SCALE = 0.5f;
+    static constexpr float MAX_SCALE = 1.0f;
+    static constexpr float SHRINK_STEP = 0.1f;
+    static constexpr float GROW_STEP = 0.05f;
+    static constexpr float GROW_HEADROOM = 0.7f;  ///< Frazione del budget sotto cui si può risalire
+    static constexpr int SHRINK_FRAMES = 4;
+    static constexpr int GROW_FRAMES = 60;
+    static constexpr int SETTLE_FRAMES = 4;       ///< Latenza delle query del GpuTimer
+
+    /**
+     * @brief Collega la destinazione della scena (FBO ridotto o schermo) e avvia la misura.
+     * @param screenWidth Larghezza della finestra
+     * @param screenHeight Altezza della finestra
+     */
+    void begin(int screenWidth, int screenHeight);
+
+    /// Chiude la misura, aggiorna la scala e compone la scena sullo schermo
+    void end(int screenWidth, int screenHeight);
+
+    /// Render target in cui si sta disegnando la scena (nullptr = schermo)
+    const RenderTarget* getTarget() const { return offscreen ? &target : nullptr; }
+
+    /// Dimensione in pixel della destinazione corrente della scena
+    glm::ivec2 getRenderSize() const { return renderSize; }
+
+    void setEnabled(bool value);
+    bool isEnabled() const { return enabled; }
+
+    /// Imposta il budget di tempo GPU del frame in millisecondi
+    void setBudgetMilliseconds(float milliseconds) { budgetMilliseconds = milliseconds > 0.5f ? milliseconds : 0.5f; }
+    float getBudgetMilliseconds() const { return budgetMilliseconds; }
+
+    float getScale() const { return scale; }
+
+    /// Tempo GPU medio del frame in millisecondi
+    float getGpuMilliseconds() const { return gpuTimer.getAverageMilliseconds(); }
+
+private:
+    /// Applica l'isteresi all'ultima misura
+    void adjustScale();
+
+    RenderTarget target{ true };
+    GpuTimer gpuTimer;
+
+    bool enabled = true;
+    bool offscreen = false;
+    float budgetMilliseconds = 10.0f;
+    float scale = MAX_SCALE;
+    int framesOverBudget = 0;
+    int framesUnderBudget = 0;
+    int settleFrames = 0;
+    glm::ivec2 renderSize = glm::ivec2(0);
+};
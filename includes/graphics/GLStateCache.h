@@ -0,0 +1,82 @@
+#pragma once
+#include <glad/glad.h>
+
+/**
+ * @brief Contatori delle chiamate OpenGL passate dalla cache di stato.
+ * @param stateIssued Cambi di stato (programma, VAO, buffer, blend, depth, polygon mode) inviati al driver
+ * @param stateElided Cambi di stato saltati perché il valore era già quello richiesto
+ * @param uniformsIssued Upload di uniform inviati al driver
+ * @param uniformsElided Upload di uniform saltati perché il valore non era cambiato
+ */
+struct GLStateStats {
+    unsigned int stateIssued = 0;
+    unsigned int stateElided = 0;
+    unsigned int uniformsIssued = 0;
+    unsigned int uniformsElided = 0;
+};
+
+/**
+ * @class GLStateCache
+ * @brief Copia lato CPU dello stato OpenGL collegato: salta i bind che non cambiano nulla.
+ *
+ * Shader, vrtx::VertexArray e i buffer passano da qui invece di chiamare direttamente
+ * glUseProgram / glBindVertexArray / glBindBuffer. È statica come gli altri manager perché
+ * i punti di bind (Shader, Vertex) non hanno un riferimento al Renderer; è il Renderer a
+ * pilotarla, invalidandola e chiudendo i contatori a ogni beginFrame().
+ *
+ * Il binding di GL_ELEMENT_ARRAY_BUFFER fa parte dello stato del VAO: cambiando VAO
+ * viene considerato sconosciuto.
+ */
+class GLStateCache {
+public:
+    /// glUseProgram, se il programma non è già in uso
+    static void useProgram(GLuint program);
+
+    /// glBindVertexArray, se il VAO non è già collegato
+    static void bindVertexArray(GLuint vao);
+
+    /// glBindBuffer per GL_ARRAY_BUFFER / GL_ELEMENT_ARRAY_BUFFER / GL_UNIFORM_BUFFER
+    static void bindBuffer(GLenum target, GLuint buffer);
+
+    /// glEnable / glDisable di GL_BLEND
+    static void setBlend(bool enabled);
+
+    /// glBlendFunc
+    static void setBlendFunc(GLenum sourceFactor, GLenum destinationFactor);
+
+    /// glEnable / glDisable di GL_DEPTH_TEST
+    static void setDepthTest(bool enabled);
+
+    /// glDepthMask: scrittura nel depth buffer (va abilitata anche per pulirlo con glClear)
+    static void setDepthWrite(bool enabled);
+
+    /// glPolygonMode(GL_FRONT_AND_BACK, mode)
+    static void setPolygonMode(GLenum mode);
+
+    /// Da chiamare prima di glDeleteProgram: il programma eliminato non è più "in uso"
+    static void onProgramDeleted(GLuint program);
+
+    /// Da chiamare prima di glDeleteVertexArrays
+    static void onVertexArrayDeleted(GLuint vao);
+
+    /// Da chiamare prima di glDeleteBuffers
+    static void onBufferDeleted(GLuint buffer);
+
+    /**
+     * @brief Dimentica tutto lo stato: il prossimo bind di ogni tipo verrà inviato.
+     * Serve quando codice esterno (es. ImGui) può aver cambiato lo stato.
+     */
+    static void invalidate();
+
+    /// Registra l'esito di un upload di uniform (usato da Shader)
+    static void countUniform(bool issued);
+
+    /// Chiude i contatori del frame e ne inizia uno nuovo
+    static void beginFrame();
+
+    /// Contatori dell'ultimo frame completato
+    static const GLStateStats& getLastFrameStats();
+
+private:
+    static void countState(bool issued);
+};
@@ -0,0 +1,153 @@
+#pragma once
+#include <vector>
+#include <glad/glad.h>
+
+namespace vrtx {
+    class VertexBuffer;
+    class VertexBufferLayout;
+}
+
+/**
+ * @brief Formato delle posizioni nella GeometryArena (sempre 2 componenti: il mondo è 2D).
+ */
+enum class VertexFormat : unsigned char {
+    Float2 = 0,    ///< 2 float (8 byte per vertice)
+    Snorm16x2 = 1, ///< 2 short normalizzati in [-1, 1] rispetto ai bound locali (4 byte per vertice)
+    Count
+};
+
+/**
+ * @brief Posizione di una mesh all'interno della GeometryArena.
+ * @param format Formato dei vertici (sceglie il VAO)
+ * @param indexType GL_UNSIGNED_SHORT o GL_UNSIGNED_INT
+ * @param baseVertex Primo vertice della mesh nel buffer del suo formato (sommato a ogni indice)
+ * @param vertexCount Numero di vertici
+ * @param indexOffset Offset in byte del primo indice nel buffer degli indici condiviso
+ * @param indexCount Numero di indici
+ */
+struct MeshRange {
+    VertexFormat format = VertexFormat::Float2;
+    GLenum indexType = GL_UNSIGNED_INT;
+    unsigned int baseVertex = 0;
+    unsigned int vertexCount = 0;
+    unsigned int indexOffset = 0;
+    unsigned int indexCount = 0;
+};
+
+/**
+ * @brief Occupazione della GeometryArena.
+ * @param vertexBytes Byte di vertici allocati (tutti i formati)
+ * @param vertexByteCapacity Byte di vertici disponibili senza crescere
+ * @param indexBytes Byte di indici allocati
+ * @param indexByteCapacity Byte di indici disponibili senza crescere
+ * @param meshCount Intervalli allocati
+ * @param quantizedMeshes Di cui con vertici Snorm16x2
+ * @param shortIndexMeshes Di cui con indici a 16 bit
+ * @param growths Numero di riallocazioni dei buffer
+ */
+struct GeometryArenaStats {
+    unsigned int vertexBytes = 0;
+    unsigned int vertexByteCapacity = 0;
+    unsigned int indexBytes = 0;
+    unsigned int indexByteCapacity = 0;
+    unsigned int meshCount = 0;
+    unsigned int quantizedMeshes = 0;
+    unsigned int shortIndexMeshes = 0;
+    unsigned int growths = 0;
+};
+
+/**
+ * @class GeometryArena
+ * @brief Buffer condivisi da tutte le mesh: un VAO e un vertex buffer per formato, un index buffer.
+ *
+ * Ogni mesh riceve un intervallo di vertici e uno di indici (MeshRange); gli indici restano
+ * relativi alla mesh e vengono spostati da glDrawElementsBaseVertex. Mesh con lo stesso
+ * formato di vertici condividono il VAO: cambiare mesh non richiede di ricollegare nulla.
+ * Il buffer degli indici è unico e collegato a tutti i VAO; indici a 16 e a 32 bit vi
+ * convivono, allineati alla propria dimensione.
+ *
+ * L'allocazione è solo in coda (le mesh vivono per tutta la partita): aggiungere geometria
+ * a runtime non crea oggetti OpenGL finché c'è capacità. Quando un buffer si riempie la
+ * sua capacità raddoppia e il contenuto viene copiato lato GPU (glCopyBufferSubData).
+ */
+class GeometryArena {
+public:
+    GeometryArena() = default;
+    ~GeometryArena();
+
+    GeometryArena(const GeometryArena&) = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+
+    /// Byte per vertice di un formato
+    static unsigned int getVertexSize(VertexFormat format);
+
+    /**
+     * @brief Copia vertici e indici già codificati in coda ai buffer condivisi.
+     * @param format Formato dei vertici in `vertexData`
+     * @param vertexData Vertici codificati (vertexCount * getVertexSize(format) byte)
+     * @param vertexCount Numero di vertici
+     * @param indexType GL_UNSIGNED_SHORT o GL_UNSIGNED_INT
+     * @param indexData Indici relativi al primo vertice della mesh
+     * @param indexCount Numero di indici
+     * @return Intervallo occupato dalla mesh
+     */
+    MeshRange allocate(VertexFormat format, const void* vertexData, unsigned int vertexCount,
+        GLenum indexType, const void* indexData, unsigned int indexCount);
+
+    /// Collega il VAO del formato (il buffer degli indici fa parte del suo stato)
+    void bind(VertexFormat format) const;
+
+    /**
+     * @brief Disegna un intervallo; il VAO del suo formato deve essere già collegato con bind().
+     * @param range Intervallo della mesh
+     * @param mode Primitiva OpenGL (es. GL_TRIANGLES)
+     */
+    void draw(const MeshRange& range, GLenum mode) const;
+
+    /// Come draw(), per `instanceCount` istanze lette dal buffer per istanza collegato
+    void drawInstanced(const MeshRange& range, GLenum mode, unsigned int instanceCount) const;
+
+    /**
+     * @brief Collega al VAO di un formato un buffer di dati per istanza (una volta sola per buffer).
+     * @param firstLocation Prima location degli attributi per istanza
+     * @return true se il VAO è stato modificato (e quindi è ora collegato)
+     */
+    bool attachInstanceBuffer(VertexFormat format, const vrtx::VertexBuffer& buffer,
+        const vrtx::VertexBufferLayout& layout, unsigned int firstLocation);
+
+    /// Occupazione corrente
+    GeometryArenaStats getStats() const;
+
+private:
+    /// VAO e vertex buffer di un formato
+    struct VertexPool {
+        GLuint vao = 0;
+        GLuint buffer = 0;
+        unsigned int count = 0;    ///< Vertici occupati
+        unsigned int capacity = 0; ///< Vertici allocati sulla GPU
+        const vrtx::VertexBuffer* instanceBuffer = nullptr; ///< Buffer per istanza collegato al VAO
+    };
+
+    /// Crea i VAO e i buffer con la capacità iniziale
+    void create();
+
+    /// Porta la capacità del buffer ad almeno `required` elementi, copiando il contenuto
+    void grow(GLuint& buffer, unsigned int& capacity, unsigned int used,
+        unsigned int required, unsigned int elementSize);
+
+    /**
+     * @brief (Ri)collega al VAO del formato l'attributo di posizione e il buffer degli indici.
+     * Gli attributi per istanza puntano a un altro buffer e non vanno toccati.
+     */
+    void setupVertexArray(VertexFormat format);
+
+    VertexPool pools[static_cast<int>(VertexFormat::Count)];
+    GLuint indexBuffer = 0;
+    unsigned int indexBytes = 0;        ///< Byte di indici occupati
+    unsigned int indexByteCapacity = 0; ///< Byte di indici allocati sulla GPU
+
+    unsigned int meshCount = 0;
+    unsigned int quantizedMeshes = 0;
+    unsigned int shortIndexMeshes = 0;
+    unsigned int growths = 0;
+};
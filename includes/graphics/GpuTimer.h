@@ -0,0 +1,43 @@
+#pragma once
+#include <glad/glad.h>
+
+/**
+ * @class GpuTimer
+ * @brief Misura il tempo GPU di un tratto di comandi con una coppia di query GL_TIMESTAMP.
+ *
+ * I risultati arrivano con qualche frame di ritardo: le coppie sono in un anello e
+ * si leggono solo quelle già disponibili, così la CPU non aspetta mai la GPU.
+ * A differenza di GL_TIME_ELAPSED, i timestamp permettono misure annidate
+ * (es. lo sfondo dentro il frame intero).
+ */
+class GpuTimer {
+public:
+    GpuTimer() = default;
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    /// Inizia la misura (crea le query al primo uso)
+    void begin();
+
+    /// Chiude la misura e raccoglie i risultati già pronti
+    void end();
+
+    /// Ultimo tempo misurato in millisecondi
+    float getMilliseconds() const { return lastMilliseconds; }
+
+    /// Media mobile esponenziale del tempo misurato, in millisecondi
+    float getAverageMilliseconds() const { return averageMilliseconds; }
+
+private:
+    static constexpr int QUERY_COUNT = 4; ///< Profondità dell'anello (frame di latenza)
+
+    GLuint startQueries[QUERY_COUNT] = {};
+    GLuint endQueries[QUERY_COUNT] = {};
+    bool pending[QUERY_COUNT] = {};
+    int current = 0;
+    bool created = false;
+    float lastMilliseconds = 0.0f;
+    float averageMilliseconds = 0.0f;
+};
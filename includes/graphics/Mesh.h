@@ -1,87 +1,170 @@
-#pragma once
-#include <vector>
-#include <memory>
-#include <glm/glm.hpp>
-#include "graphics/Vertex.h"
-
-class Shader;
-
-namespace vrtx {
-    class VertexArray;
-    class VertexBuffer;
-    class IndexBuffer;
-    class VertexBufferLayout;
-}
-
-/**
- * @brief Rappresenta una mesh 2D o 3D composta da vertici e indici.
- *
- * La classe si occupa della gestione dei buffer OpenGL (VAO, VBO, EBO)
- * e della configurazione del layout dei vertici.  responsabile della
- * preparazione dei dati per il rendering.
- */
-class Mesh {
-private:
-    unsigned int meshId; ///< Identificatore univoco della mesh (gestito dallengine)
-    std::vector<float> vertices; ///< Dati dei vertici (posizioni, colori, ecc.)
-    std::vector<unsigned int> indices; ///< Indici dei vertici per la triangolazione
-
-    /// Punti estremi dellAxis-Aligned Bounding Box (AABB)
-    glm::vec2 minPoint = glm::vec2(0.0f);
-    glm::vec2 maxPoint = glm::vec2(0.0f);
-
-    /// Buffer OpenGL per la rappresentazione della mesh
-    std::unique_ptr<vrtx::VertexArray> va;
-    std::unique_ptr<vrtx::VertexBuffer> vb;
-    std::unique_ptr<vrtx::IndexBuffer> ib;
-
-    /**
-     * @brief Configura i buffer OpenGL (VAO, VBO, IBO) e il layout dei vertici.
-     *
-     * Metodo interno chiamato automaticamente dal costruttore o dai setter
-     * per inizializzare la struttura grafica della mesh.
-     */
-    void setupMesh();
-
-public:
-    /// Costruttore di default: crea una mesh vuota
-    Mesh() = default;
-
-    /**
-     * @brief Costruttore che inizializza la mesh con vertici e indici.
-     * @param vertices Dati dei vertici (posizioni, colori, ecc.)
-     * @param indices Indici che definiscono la topologia della mesh
-     */
-    Mesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices);
-
-    /// Distruttore di default (i buffer vengono gestiti automaticamente da unique_ptr)
-    ~Mesh() = default;
-
-    /// Imposta i vertici della mesh e ricostruisce i buffer
-    void setVertices(const std::vector<float>& vertices);
-
-    /// Imposta gli indici della mesh e ricostruisce i buffer
-    void setIndices(const std::vector<unsigned int>& indices);
-
-    /// Restituisce il vettore dei vertici
-    std::vector<float> getVertices() const { return vertices; }
-
-    /**
-     * @brief Esegue il rendering della mesh.
-     * @param shader Shader da utilizzare per il disegno
-     * @param usage Modalit di disegno OpenGL (es. GL_TRIANGLES)
-     */
-    void draw(Shader& shader, GLenum usage) const;
-
-    /// Restituisce lID della mesh
-    unsigned int getId() const { return meshId; }
-
-    /// Imposta lID della mesh (ad esempio assegnato da un gestore di risorse)
-    void setId(const unsigned int id) { meshId = id; }
-
-    /// Imposta il punto minimo dellAABB
-    void setMin(glm::vec2 vec) { minPoint = vec; }
-
-    /// Imposta il punto massimo dellAABB
-    void setMax(glm::vec2 vec) { maxPoint = vec; }
-};
+#pragma once
+#include <vector>
+#include <memory>
+#include <glm/glm.hpp>
+#include "graphics/Vertex.h"
+#include "graphics/GeometryArena.h"
+#include "math/Affine2D.h"
+
+class Shader;
+
+/**
+ * @brief Rappresenta una mesh 2D o 3D composta da vertici e indici.
+ *
+ * I dati dei vertici e degli indici vengono copiati nella GeometryArena condivisa
+ * (vedi MeshManager::getArena): la mesh ricorda solo il proprio intervallo e disegna
+ * con glDrawElementsBaseVertex sul VAO comune a tutte le mesh dello stesso formato.
+ *
+ * Sulla CPU i vertici restano 3 float (usati da bound e collisioni); sulla GPU il formato
+ * viene scelto automaticamente (posizioni a 16 bit normalizzate, indici a 16 bit quando
+ * bastano). Chi disegna la mesh deve comporre la propria matrice model con
+ * getDequantization().
+ */
+class Mesh {
+private:
+    unsigned int meshId; ///< Identificatore univoco della mesh (gestito dall’engine)
+    std::vector<float> vertices; ///< Dati dei vertici (posizioni, colori, ecc.)
+    std::vector<unsigned int> indices; ///< Indici dei vertici per la triangolazione
+
+    /// Punti estremi dell’Axis-Aligned Bounding Box (AABB) in spazio locale
+    glm::vec2 minPoint = glm::vec2(0.0f);
+    glm::vec2 maxPoint = glm::vec2(0.0f);
+
+    /// Raggio del cerchio che contiene la mesh, centrato nel centro dell'AABB locale
+    float boundingRadius = 0.0f;
+
+    /// Intervallo della mesh nella GeometryArena
+    MeshRange range;
+
+    /// Vero dopo il primo caricamento nella GeometryArena
+    bool uploaded = false;
+
+    /// Riporta le posizioni caricate sulla GPU in spazio locale (identità se non quantizzate)
+    Affine2D dequantization;
+
+    /**
+     * @brief Copia vertici e indici nella GeometryArena condivisa.
+     *
+     * Metodo interno chiamato automaticamente dal costruttore o dai setter. L'arena
+     * alloca solo in coda: ricaricare una mesh occupa un nuovo intervallo.
+     */
+    void setupMesh();
+
+    /**
+     * @brief Calcola AABB locale e cerchio di ingombro a partire dai vertici.
+     *
+     * Viene chiamato alla creazione della mesh, così che anche le mesh non generate
+     * da HermiteMesh abbiano dei bound validi per le collisioni.
+     */
+    void computeBounds();
+
+public:
+    /// Costruttore di default: crea una mesh vuota
+    Mesh() = default;
+
+    /**
+     * @brief Costruttore che inizializza la mesh con vertici e indici.
+     * @param vertices Dati dei vertici (posizioni, colori, ecc.)
+     * @param indices Indici che definiscono la topologia della mesh
+     */
+    Mesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices);
+
+    /// Distruttore di default (la geometria resta nella GeometryArena)
+    ~Mesh() = default;
+
+    /// Imposta i vertici della mesh e la ricarica nell'arena
+    void setVertices(const std::vector<float>& vertices);
+
+    /// Imposta gli indici della mesh e la ricarica nell'arena
+    void setIndices(const std::vector<unsigned int>& indices);
+
+    /// Intervallo occupato dalla mesh nella GeometryArena
+    const MeshRange& getRange() const { return range; }
+
+    /// Vero se le posizioni sulla GPU sono quantizzate (la model va composta con getDequantization)
+    bool isQuantized() const { return range.format == VertexFormat::Snorm16x2; }
+
+    /**
+     * @brief Trasformazione da posizioni GPU a spazio locale: `model * getDequantization()`.
+     * Identità per le mesh non quantizzate.
+     */
+    const Affine2D& getDequantization() const { return dequantization; }
+
+    /// Restituisce il vettore dei vertici (per riferimento, senza copia)
+    const std::vector<float>& getVertices() const { return vertices; }
+
+    /**
+     * @brief Esegue il rendering della mesh.
+     * @param shader Shader da utilizzare per il disegno
+     * @param usage Modalità di disegno OpenGL (es. GL_TRIANGLES)
+     */
+    void draw(Shader& shader, GLenum usage) const;
+
+    /// Collega il VAO dell'arena (condiviso: mesh diverse non richiedono un nuovo bind)
+    void bind() const;
+
+    /// Scollega il VAO
+    void unbind() const;
+
+    /**
+     * @brief Disegna la mesh assumendo che sia già collegata con bind().
+     * @param usage Modalità di disegno OpenGL (es. GL_TRIANGLES)
+     */
+    void drawElements(GLenum usage) const;
+
+    /**
+     * @brief Disegna `instanceCount` istanze assumendo che la mesh sia già collegata con bind().
+     * @param usage Modalità di disegno OpenGL (es. GL_TRIANGLES)
+     * @param instanceCount Numero di istanze lette dal buffer collegato
+     */
+    void drawElementsInstanced(GLenum usage, unsigned int instanceCount) const;
+
+    /**
+     * @brief Collega al VAO dell'arena un buffer di dati per istanza.
+     *
+     * Gli attributi per vertice usano la location 0: quelli per istanza partono da
+     * `INSTANCE_ATTRIBUTE_LOCATION`. Il VAO è condiviso, quindi il collegamento avviene
+     * una sola volta per tutte le mesh; gli shader non instanced ignorano gli attributi aggiuntivi.
+     * @param buffer Buffer condiviso con i dati delle istanze
+     * @param layout Layout di un elemento del buffer
+     * @return true se il VAO è stato modificato (e quindi il VAO collegato è cambiato)
+     */
+    bool attachInstanceBuffer(const vrtx::VertexBuffer& buffer, const vrtx::VertexBufferLayout& layout);
+
+    /**
+     * @brief Disegna `instanceCount` copie della mesh con una sola chiamata.
+     * @param usage Modalità di disegno OpenGL (es. GL_TRIANGLES)
+     * @param instanceCount Numero di istanze lette dal buffer collegato
+     */
+    void drawInstanced(GLenum usage, unsigned int instanceCount) const;
+
+    /// Prima location degli attributi per istanza
+    static constexpr unsigned int INSTANCE_ATTRIBUTE_LOCATION = 1;
+
+    /// Restituisce l’ID della mesh
+    unsigned int getId() const { return meshId; }
+
+    /// Imposta l’ID della mesh (ad esempio assegnato da un gestore di risorse)
+    void setId(const unsigned int id) { meshId = id; }
+
+    /// Imposta il punto minimo dell’AABB
+    void setMin(glm::vec2 vec) { minPoint = vec; }
+
+    /// Imposta il punto massimo dell’AABB
+    void setMax(glm::vec2 vec) { maxPoint = vec; }
+
+    /// Imposta il raggio del cerchio di ingombro
+    void setBoundingRadius(float radius) { boundingRadius = radius; }
+
+    /// Restituisce il punto minimo dell’AABB locale
+    const glm::vec2& getMin() const { return minPoint; }
+
+    /// Restituisce il punto massimo dell’AABB locale
+    const glm::vec2& getMax() const { return maxPoint; }
+
+    /// Restituisce il centro dell’AABB locale (centro del cerchio di ingombro)
+    glm::vec2 getBoundsCenter() const { return (minPoint + maxPoint) * 0.5f; }
+
+    /// Restituisce il raggio del cerchio di ingombro in spazio locale
+    float getBoundingRadius() const { return boundingRadius; }
+};
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Contatori della cache dei programmi dall'avvio.
+ * @param hits Programmi caricati dal binario su disco
+ * @param misses Programmi non trovati (o rifiutati dal driver) e compilati dai sorgenti
+ * @param stores Binari scritti su disco
+ */
+struct ProgramCacheStats {
+    unsigned int hits = 0;
+    unsigned int misses = 0;
+    unsigned int stores = 0;
+};
+
+/**
+ * @class ProgramCache
+ * @brief Cache su disco dei programmi linkati (glGetProgramBinary / glProgramBinary).
+ *
+ * La chiave è un hash FNV-1a a 64 bit dei sorgenti e delle stringhe GL_VENDOR,
+ * GL_RENDERER e GL_VERSION: aggiornare driver o GPU genera chiavi nuove invece di
+ * caricare binari incompatibili. Ogni programma è un file `<chiave>.bin` nella directory
+ * della cache, con un'intestazione che ripete chiave e formato del binario.
+ *
+ * Il loader GLAD del progetto copre solo il core 3.3: le funzioni di
+ * GL_ARB_get_program_binary (core dal 4.1) vengono risolte in init() con glfwGetProcAddress.
+ * Senza supporto la cache resta disabilitata e ogni load() fallisce, così Shader
+ * ricade sempre sulla compilazione dai sorgenti.
+ */
+class ProgramCache {
+public:
+    /**
+     * @brief Risolve le funzioni del driver e prepara la directory della cache.
+     * Richiede un contesto OpenGL attivo.
+     * @param directory Directory dei binari (creata se manca)
+     */
+    static void init(const std::string& directory);
+
+    /**
+     * @brief Crea un programma dal binario in cache per questi sorgenti.
+     * @return ID del programma linkato, 0 se assente, corrotto o rifiutato dal driver
+     */
+    static unsigned int load(const std::string& vertexCode, const std::string& fragmentCode);
+
+    /// Da chiamare prima di glLinkProgram: chiede al driver di conservare il binario
+    static void prepareForLink(unsigned int program);
+
+    /// Salva il binario di un programma appena linkato dai sorgenti
+    static void store(unsigned int program, const std::string& vertexCode, const std::string& fragmentCode);
+
+    /// Abilita o disabilita la cache (per misurare l'avvio senza)
+    static void setEnabled(bool value) { enabled = value; }
+
+    /// Vero se il driver supporta i binari e la cache è abilitata
+    static bool isActive() { return supported && enabled; }
+
+    static const ProgramCacheStats& getStats() { return stats; }
+
+private:
+    /// Nome del file del programma con questi sorgenti
+    static std::string pathFor(uint64_t key);
+
+    /// Hash dei sorgenti combinato con quello del driver
+    static uint64_t makeKey(const std::string& vertexCode, const std::string& fragmentCode);
+
+    static std::string directory;
+    static uint64_t driverHash;
+    static bool supported;
+    static bool enabled;
+    static ProgramCacheStats stats;
+};
@@ -0,0 +1,109 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "math/Affine2D.h"
+
+/**
+ * @brief Gruppi di disegno, dal più lontano al più vicino.
+ *
+ * Ogni layer occupa una fascia di profondità propria (vedi RenderQueue::layerDepth):
+ * con il depth test il player copre sempre il mondo, l'HUD il player e gli overlay di
+ * debug l'HUD, qualunque sia l'ordine di disegno.
+ */
+enum class RenderLayer : uint8_t {
+    World = 0,  ///< Ostacoli, proiettili
+    Player = 1, ///< Navicella del giocatore
+    Hud = 2,    ///< Interfaccia di gioco (cuori)
+    Debug = 3   ///< Overlay di debug disegnati con mesh (le linee passano da DebugDraw)
+};
+
+/**
+ * @brief Una richiesta di disegno, con tutto ciò che serve per eseguirla più tardi.
+ * @param sortKey Chiave di ordinamento a 64 bit (vedi RenderQueue::makeKey)
+ * @param meshId ID della mesh
+ * @param shaderId ID dello shader
+ * @param mode Primitiva OpenGL (es. GL_TRIANGLES)
+ * @param model Trasformazione mondo della sub-mesh
+ * @param depth Profondità finale in spazio mondo (fascia del layer + profondità della sub-mesh)
+ * @param color Colore
+ */
+struct DrawPacket {
+    uint64_t sortKey = 0;
+    unsigned int meshId = 0;
+    unsigned int shaderId = 0;
+    GLenum mode = GL_TRIANGLES;
+    Affine2D model;
+    float depth = 0.0f;
+    glm::vec4 color = glm::vec4(1.0f);
+};
+
+/**
+ * @class RenderQueue
+ * @brief Coda dei pacchetti di disegno di un frame, ordinata una sola volta prima dell'esecuzione.
+ *
+ * Scena, HUD e debug accodano pacchetti invece di disegnare subito; il Renderer ordina la
+ * coda per chiave ed esegue i pacchetti in sequenza, così quelli con lo stesso shader e la
+ * stessa mesh risultano adiacenti e i cambi di stato possono essere saltati.
+ *
+ * Layout della chiave (dal bit più significativo):
+ *
+ *     | trasparente (1) | layer (2) | profondità (10) | shader (11) | mesh (16) | sequenza (24) |
+ *
+ * - tutti gli opachi precedono tutti i trasparenti: sono due passate distinte;
+ * - gli opachi vanno dal più vicino al più lontano (layer e profondità invertiti), così il
+ *   depth test scarta presto i frammenti coperti; a pari profondità sono raggruppati per shader e mesh;
+ * - per i trasparenti shader e mesh valgono 0: restano in ordine dal più lontano al più vicino
+ *   e di invio, che è quello richiesto dal blending;
+ * - la sequenza (ordine di invio) rende l'ordinamento stabile e deterministico.
+ */
+class RenderQueue {
+public:
+    /**
+     * @brief Costruisce la chiave di ordinamento di un pacchetto.
+     * @param layer Gruppo di disegno
+     * @param translucent Vero se il colore ha alpha < 1
+     * @param depth Profondità del layer, quantizzata su [-1, 1]
+     * @param shaderId ID dello shader
+     * @param meshId ID della mesh
+     * @param sequence Ordine di invio nel frame
+     */
+    static uint64_t makeKey(RenderLayer layer, bool translucent, float depth,
+        unsigned int shaderId, unsigned int meshId, uint32_t sequence);
+
+    /**
+     * @brief Profondità in spazio mondo di una sub-mesh di un layer.
+     *
+     * Le fasce distano LAYER_BAND e partono da FIRST_BAND; la profondità della sub-mesh
+     * (offset Z dei layer della navicella) sposta il pacchetto dentro la fascia.
+     * Tutte le fasce stanno davanti a BACKGROUND_DEPTH.
+     */
+    static float layerDepth(RenderLayer layer, float depth);
+
+    static constexpr float FIRST_BAND = -0.6f;          ///< Centro della fascia del layer World
+    static constexpr float LAYER_BAND = 0.4f;           ///< Distanza tra i centri di due fasce
+    static constexpr float SUBMESH_DEPTH_SCALE = 0.15f; ///< Escursione massima dentro una fascia
+    static constexpr float BACKGROUND_DEPTH = -0.99f;   ///< Sfondo: dietro a tutte le fasce, prima del piano far
+
+    /// Accoda un pacchetto calcolandone profondità finale e chiave
+    void submit(RenderLayer layer, DrawPacket packet);
+
+    /// Ordina i pacchetti per chiave
+    void sort();
+
+    /// Indice del primo pacchetto trasparente (valido dopo sort())
+    size_t getTranslucentBegin() const;
+
+    /// Svuota la coda (la memoria resta allocata per il frame successivo)
+    void clear() { packets.clear(); }
+
+    /// Pacchetti accodati (ordinati dopo sort())
+    const std::vector<DrawPacket>& getPackets() const { return packets; }
+
+    /// Numero di pacchetti accodati
+    size_t size() const { return packets.size(); }
+
+private:
+    std::vector<DrawPacket> packets; ///< Pacchetti del frame corrente
+};
@@ -0,0 +1,71 @@
+#pragma once
+#include <glad/glad.h>
+
+/**
+ * @class RenderTarget
+ * @brief Framebuffer fuori schermo con una texture colore RGBA8 (e, a richiesta, un depth buffer).
+ *
+ * Serve per disegnare a una risoluzione diversa da quella della finestra e poi riportare
+ * il risultato sul framebuffer di default con blitToScreen(), che filtra bilinearmente.
+ * Gli oggetti OpenGL vengono creati al primo resize() con dimensioni valide.
+ */
+class RenderTarget {
+public:
+    /// @param withDepth Vero per allegare anche un renderbuffer di profondità (24 bit)
+    explicit RenderTarget(bool withDepth = false);
+    ~RenderTarget();
+
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+
+    /**
+     * @brief Alloca (o rialloca) gli allegati alla dimensione indicata.
+     * @return true se la dimensione è cambiata (il contenuto precedente è perso)
+     */
+    bool resize(int newWidth, int newHeight);
+
+    /// Collega il framebuffer come destinazione e imposta il viewport sulla sua dimensione
+    void bind() const;
+
+    /// Torna al framebuffer di default con il viewport indicato
+    static void bindDefault(int viewportWidth, int viewportHeight);
+
+    /**
+     * @brief Collega una destinazione qualsiasi: il target indicato o, se nullptr, lo schermo.
+     * @param target Render target da collegare (nullptr = framebuffer di default)
+     * @param screenWidth Larghezza del viewport se si torna allo schermo
+     * @param screenHeight Altezza del viewport se si torna allo schermo
+     */
+    static void bindOrDefault(const RenderTarget* target, int screenWidth, int screenHeight);
+
+    /**
+     * @brief Copia la texture colore sul framebuffer di default, scalandola.
+     * @param screenWidth Larghezza della finestra
+     * @param screenHeight Altezza della finestra
+     * @param filter GL_LINEAR (bilineare) o GL_NEAREST
+     */
+    void blitToScreen(int screenWidth, int screenHeight, GLenum filter = GL_LINEAR) const;
+
+    /**
+     * @brief Copia la texture colore in un altro render target, scalandola alla sua dimensione.
+     * @param destination Target di destinazione (nullptr = schermo di destWidth x destHeight)
+     */
+    void blitTo(const RenderTarget* destination, int destWidth, int destHeight, GLenum filter = GL_LINEAR) const;
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    /// Vero se il framebuffer è stato creato ed è completo
+    bool isValid() const { return complete; }
+
+private:
+    void release();
+
+    bool hasDepth;
+    GLuint framebuffer = 0;
+    GLuint colorTexture = 0;
+    GLuint depthBuffer = 0;
+    int width = 0;
+    int height = 0;
+    bool complete = false;
+};
@@ -1,61 +1,218 @@
-#pragma once
-#include <memory>
-#include <vector>
-#include <string>
-#include <glad/glad.h>
-#include <glm/glm.hpp>
-
-class Mesh;
-class MeshManager;
-class ShaderManager;
-class Shader;
-class Entity;
-struct AABB;
-
-/**
- * @brief Gestisce il rendering di mesh ed entit nel motore grafico.
- *
- * Contiene lo stato della telecamera (matrici view/projection)
- * e le funzioni per disegnare oggetti tramite ID o componenti di rendering.
- */
-class Renderer {
-private:
-    std::vector<std::shared_ptr<Mesh>> meshes; ///< Cache locale delle mesh da disegnare
-    glm::mat4 projection; ///< Matrice di proiezione corrente
-    glm::mat4 view; ///< Matrice di vista corrente
-
-public:
-    Renderer();
-    ~Renderer() = default;
-
-    /// Aggiunge una mesh alla lista di rendering
-    void addMesh(const std::shared_ptr<Mesh>& mesh);
-
-    /// Pulisce la scena corrente
-    void clear();
-
-    /// Imposta le matrici di vista e proiezione (camera)
-    void setCamera(const glm::mat4& viewMat, const glm::mat4& projMat);
-
-    /**
-     * @brief Disegna una mesh tramite ID e shader specifico.
-     *
-     * @param meshId ID della mesh registrata
-     * @param shaderId ID dello shader registrato
-     * @param color Colore del disegno
-     * @param model Matrice di trasformazione modello
-     * @param mode Modalit di disegno (es. GL_TRIANGLES)
-     */
-    void drawMesh(const unsigned int meshId, const unsigned int shaderId, const glm::vec4& color, const glm::mat4& model, const GLenum mode);
-
-    /**
-     * @brief Disegna unentit completa (con submesh e shader multipli).
-     *
-     * @param entity Entit da disegnare
-     * @param mode Modalit di disegno (default GL_TRIANGLES)
-     */
-    void drawEntityByInfo(Entity& entity, const GLenum mode = GL_TRIANGLES);
-
-    /// Disegna una bounding box 2D per il debug
-    void drawBoundingBox(const AABB& box, const glm::vec4& color, const glm::mat4& view, const glm::mat4& projection);
-};
+#pragma once
+#include <memory>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "graphics/RenderQueue.h"
+#include "graphics/DebugDraw.h"
+
+class Mesh;
+class MeshManager;
+class ShaderManager;
+class Shader;
+class Entity;
+
+namespace vrtx {
+    class VertexBuffer;
+    class UniformBuffer;
+}
+
+/**
+ * @brief Dati condivisi da tutti gli shader in un frame, in layout std140.
+ *
+ * Corrisponde al blocco `FrameData` dichiarato negli shader (binding point
+ * Shader::FRAME_DATA_BINDING): viene scritto una sola volta per frame, così per
+ * ogni disegno restano da caricare soltanto `model` e `uColor`.
+ * @param view Matrice di vista (offset 0)
+ * @param projection Matrice di proiezione (offset 64)
+ * @param resolution Dimensione della finestra in pixel (offset 128)
+ * @param time Tempo totale trascorso in secondi (offset 136)
+ */
+struct FrameData {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::vec2 resolution;
+    float time;
+    float padding; ///< std140 arrotonda il blocco a un multiplo di 16 byte
+};
+static_assert(sizeof(FrameData) == 144, "FrameData deve rispettare il layout std140");
+
+/**
+ * @brief Contatori di rendering di un frame.
+ * @param drawCalls Chiamate di disegno effettivamente inviate alla GPU
+ * @param instancedDrawCalls Di cui chiamate instanced (un gruppo mesh/shader ciascuna)
+ * @param instances Sub-mesh disegnate tramite i gruppi instanced
+ * @param subMeshes Sub-mesh disegnate in totale: senza instancing sarebbe una chiamata ciascuna
+ * @param packets Pacchetti eseguiti dalla coda di rendering
+ * @param programBinds Cambi di programma effettuati dalla coda
+ * @param programBindsSkipped Pacchetti che hanno trovato il programma già collegato
+ * @param vaoBinds Cambi di VAO effettuati dalla coda (uno per formato di vertici: le mesh condividono la GeometryArena)
+ * @param vaoBindsSkipped Pacchetti che hanno trovato il VAO già collegato
+ * @param debugLines Segmenti di debug disegnati (tutti in un'unica chiamata)
+ */
+struct RenderStats {
+    unsigned int drawCalls = 0;
+    unsigned int instancedDrawCalls = 0;
+    unsigned int instances = 0;
+    unsigned int subMeshes = 0;
+    unsigned int packets = 0;
+    unsigned int programBinds = 0;
+    unsigned int programBindsSkipped = 0;
+    unsigned int vaoBinds = 0;
+    unsigned int vaoBindsSkipped = 0;
+    unsigned int debugLines = 0;
+};
+
+/**
+ * @brief Gestisce il rendering di mesh ed entità nel motore grafico.
+ *
+ * Contiene lo stato della telecamera (matrici view/projection, pubblicate agli shader
+ * tramite il blocco FrameData) e le funzioni per disegnare oggetti tramite ID o
+ * componenti di rendering.
+ */
+class Renderer {
+private:
+    std::vector<std::shared_ptr<Mesh>> meshes; ///< Cache locale delle mesh da disegnare
+    glm::mat4 projection; ///< Matrice di proiezione corrente
+    glm::mat4 view; ///< Matrice di vista corrente
+    float interpolationAlpha = 1.0f; ///< Frazione di passo usata per interpolare i transform
+    std::unique_ptr<vrtx::UniformBuffer> frameBuffer; ///< UBO del blocco FrameData
+
+    /**
+     * @brief Dati di una sub-mesh disegnata in un gruppo instanced (3 vec4 per istanza).
+     * @param linear Colonne x (xy) e y (zw) della trasformazione 2D
+     * @param translation Traslazione (xy) e profondità del layer (z)
+     * @param color Colore della sub-mesh
+     */
+    struct InstanceData {
+        glm::vec4 linear;
+        glm::vec4 translation;
+        glm::vec4 color;
+    };
+
+    std::unordered_map<unsigned int, unsigned int> instancedShaders; ///< Shader base -> variante instanced
+    std::unique_ptr<vrtx::VertexBuffer> instanceBuffer; ///< Buffer di streaming per i dati delle istanze
+    std::vector<InstanceData> instanceScratch; ///< Dati delle istanze del gruppo in corso (riusato tra i frame)
+
+    RenderQueue queue; ///< Pacchetti di disegno del frame
+    size_t translucentBegin = 0; ///< Primo pacchetto trasparente della coda ordinata da flushOpaque()
+    DebugDraw debugDraw; ///< Linee di debug del frame, disegnate in coda a flushTranslucent()
+
+    RenderStats stats;          ///< Contatori del frame in corso
+    RenderStats lastFrameStats; ///< Contatori dell'ultimo frame completato
+
+    /// Esegue i pacchetti [first, last) della coda ordinata
+    void drawPackets(size_t first, size_t last);
+
+public:
+    Renderer();
+    ~Renderer();
+
+    /// Chiude i contatori del frame precedente e ne inizia uno nuovo
+    void beginFrame();
+
+    /// Contatori dell'ultimo frame completato
+    const RenderStats& getStats() const { return lastFrameStats; }
+
+    /// Aggiunge una mesh alla lista di rendering
+    void addMesh(const std::shared_ptr<Mesh>& mesh);
+
+    /// Pulisce la scena corrente
+    void clear();
+
+    /// Imposta le matrici di vista e proiezione (camera)
+    void setCamera(const glm::mat4& viewMat, const glm::mat4& projMat);
+
+    /**
+     * @brief Scrive il blocco FrameData (camera corrente, risoluzione e tempo) nell'UBO condiviso.
+     * Da chiamare una volta per frame, dopo setCamera e prima di qualsiasi disegno.
+     * @param resolution Dimensione della finestra in pixel
+     * @param time Tempo totale trascorso in secondi
+     */
+    void updateFrameData(const glm::vec2& resolution, float time);
+
+    /**
+     * @brief Imposta la frazione di passo di simulazione trascorsa (1 = stato corrente).
+     * Le entità in movimento vengono disegnate interpolando tra lo stato precedente e quello corrente.
+     */
+    void setInterpolationAlpha(float alpha) { interpolationAlpha = alpha; }
+
+    /**
+     * @brief Disegna una mesh tramite ID e shader specifico.
+     *
+     * @param meshId ID della mesh registrata
+     * @param shaderId ID dello shader registrato
+     * @param color Colore del disegno
+     * @param model Trasformazione modello 2D (espansa in mat4 solo per l'upload)
+     * @param mode Modalità di disegno (es. GL_TRIANGLES)
+     */
+    void drawMesh(const unsigned int meshId, const unsigned int shaderId, const glm::vec4& color, const Affine2D& model, const GLenum mode);
+
+    /**
+     * @brief Disegna un’entità completa (con submesh e shader multipli).
+     *
+     * @param entity Entità da disegnare
+     * @param mode Modalità di disegno (default GL_TRIANGLES)
+     */
+    void drawEntityByInfo(Entity& entity, const GLenum mode = GL_TRIANGLES);
+
+    /**
+     * @brief Registra la variante instanced di uno shader.
+     *
+     * Le sub-mesh che usano `baseShaderId` potranno essere raggruppate e disegnate
+     * con `instancedShaderId`, che legge trasformazione e colore dagli attributi per istanza.
+     */
+    void setInstancedShader(unsigned int baseShaderId, unsigned int instancedShaderId);
+
+    /**
+     * @brief Accoda un pacchetto per ogni sub-mesh visibile di un'entità.
+     *
+     * La trasformazione viene calcolata subito (matrice in cache o stato interpolato).
+     * @param entity Entità da disegnare
+     * @param layer Gruppo di disegno
+     * @param mode Modalità di disegno (default GL_TRIANGLES)
+     */
+    void submitEntity(Entity& entity, RenderLayer layer = RenderLayer::World, const GLenum mode = GL_TRIANGLES);
+
+    /**
+     * @brief Accoda il disegno di una singola mesh.
+     * @param meshId ID della mesh registrata
+     * @param shaderId ID dello shader registrato
+     * @param color Colore del disegno
+     * @param model Trasformazione modello 2D
+     * @param layer Gruppo di disegno
+     * @param mode Modalità di disegno (default GL_TRIANGLES)
+     */
+    void submitMesh(unsigned int meshId, unsigned int shaderId, const glm::vec4& color,
+        const Affine2D& model, RenderLayer layer, const GLenum mode = GL_TRIANGLES);
+
+    /// Accoda il contorno di una bounding box di debug (vedi DebugDraw)
+    void submitBoundingBox(const AABB& box, const glm::vec4& color);
+
+    /// Primitive di debug del frame: linee, riquadri e cerchi, disegnati dopo la coda
+    DebugDraw& getDebugDraw() { return debugDraw; }
+
+    /**
+     * @brief Ordina la coda ed esegue la passata opaca (depth test e scrittura, dal più vicino).
+     *
+     * Pacchetti consecutivi con la stessa mesh e lo stesso shader formano un gruppo:
+     * se lo shader ha una variante instanced il gruppo viene disegnato con una sola
+     * chiamata, altrimenti con una chiamata per pacchetto ma senza ricollegare nulla.
+     * Programma e VAO vengono cambiati solo quando differiscono da quelli già collegati.
+     *
+     * Tra flushOpaque() e flushTranslucent() si può disegnare lo sfondo a
+     * RenderQueue::BACKGROUND_DEPTH: i pixel già coperti dagli opachi vengono scartati.
+     */
+    void flushOpaque();
+
+    /**
+     * @brief Esegue la passata trasparente (dal più lontano, senza scrittura della profondità),
+     * svuota la coda e disegna con una sola chiamata le primitive di DebugDraw.
+     */
+    void flushTranslucent();
+
+    /// Entrambe le passate, senza nulla in mezzo
+    void flush();
+};
@@ -1,51 +1,167 @@
-/**
- * @file Shader.h
- * @brief Dichiarazione della classe Shader, che incapsula la gestione di uno shader OpenGL.
- */
-
-#pragma once
-#include <string>
-#include <glm/glm.hpp>
-#include <glad/glad.h>
-#include <unordered_map>
-
- /**
-  * @class Shader
-  * @brief Gestisce la creazione, compilazione e utilizzo di programmi shader OpenGL.
-  *
-  * Fornisce metodi per il binding e limpostazione efficiente di uniform.
-  */
-class Shader {
-private:
-    unsigned int rendererId;  ///< Identificatore del programma shader OpenGL.
-    mutable std::unordered_map<std::string, int> uniformLocationCache; ///< Cache per le uniform.
-
-public:
-    Shader() = default;
-    Shader(const std::string& vertexShader, const std::string& fragmentShader);
-    ~Shader();
-
-    /** @brief Attiva lo shader per il rendering. */
-    void bind() const;
-
-    /** @brief Disattiva lo shader. */
-    void unbind();
-
-    // --- Uniform setters ---
-    void setUniform4f(const std::string& name, float v0, float v1, float v2, float v3);
-    void setUniformVec4(const std::string& name, const glm::vec4& vec);
-    void setUniformMat4(const std::string& name, const glm::mat4& matrix);
-    void setUniform1f(const std::string& name, float value);
-    void setUniformVec2(const std::string& name, const glm::vec2& vec);
-
-    /** @return ID OpenGL dello shader. */
-    unsigned int getId() const { return rendererId; }
-
-    /** @return true se lo shader  valido, false altrimenti. */
-    bool isValid() const { return rendererId != 0; }
-
-private:
-    bool compileShader(unsigned int shader, const std::string& type);
-    unsigned int createShader(const std::string& vertexCode, const std::string& fragmentCode);
-    int getUniformLocationCached(const std::string& name) const;
-};
+/**
+ * @file Shader.h
+ * @brief Dichiarazione della classe Shader, che incapsula la gestione di uno shader OpenGL.
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glad/glad.h>
+#include <unordered_map>
+
+/**
+ * @brief Nome di una uniform con il suo hash FNV-1a a 32 bit.
+ *
+ * Il costruttore è constexpr: per le costanti in `uniforms` (e per i letterali usati
+ * come argomento dei setter, quando il compilatore li valuta a compile time) l'hash
+ * non costa nulla a runtime e non viene costruita nessuna std::string.
+ */
+struct UniformName {
+    uint32_t hash;    ///< Hash FNV-1a del nome
+    const char* name; ///< Nome nel sorgente GLSL (solo per i messaggi di errore)
+
+    constexpr UniformName(const char* text) : hash(fnv1a(text)), name(text) {}
+
+    /// Hash FNV-1a a 32 bit di una stringa terminata da zero
+    static constexpr uint32_t fnv1a(const char* text) {
+        uint32_t value = 2166136261u;
+        while (*text) {
+            value = (value ^ static_cast<uint8_t>(*text++)) * 16777619u;
+        }
+        return value;
+    }
+};
+
+/// Uniform per disegno comuni a tutti gli shader di geometria
+namespace uniforms {
+    constexpr UniformName Model("model");
+    constexpr UniformName Color("uColor");
+}
+
+/**
+ * @brief Riferimento a una uniform già risolta di uno specifico Shader.
+ *
+ * È l'indice dello slot nel programma: i setter che ricevono un handle accedono
+ * direttamente allo slot, senza hash né ricerche. Vale solo per lo shader che lo ha emesso.
+ */
+struct UniformHandle {
+    int index = -1; ///< Slot nel programma (-1 = uniform inesistente)
+
+    /// Vero se la uniform è attiva nel programma
+    bool isValid() const { return index >= 0; }
+};
+
+ /**
+  * @class Shader
+  * @brief Gestisce la creazione, compilazione e utilizzo di programmi shader OpenGL.
+  *
+  * Fornisce metodi per il binding e l’impostazione efficiente di uniform: le uniform attive
+ * vengono registrate una volta dopo il link e i setter lavorano su indici interi.
+  */
+class Shader {
+private:
+    /**
+     * @brief Location di una uniform e copia dell'ultimo valore caricato.
+     *
+     * I valori delle uniform restano nel programma anche quando non è in uso: se il nuovo
+     * valore coincide con la copia, la chiamata glUniform* può essere saltata.
+     * @param location Location OpenGL (-1 se la uniform non esiste o è stata eliminata dal compilatore)
+     * @param size Numero di float validi in `value` (0 = nessun valore caricato)
+     * @param value Ultimo valore caricato
+     */
+    struct UniformSlot {
+        int location = -1;
+        int size = 0;
+        float value[16];
+    };
+
+    unsigned int rendererId = 0;  ///< Identificatore del programma shader OpenGL.
+    unsigned int vertexShaderId = 0;   ///< Shader in compilazione (solo durante la costruzione)
+    unsigned int fragmentShaderId = 0; ///< Shader in compilazione (solo durante la costruzione)
+    bool building = false;             ///< Compilazione/link avviati ma esito non ancora letto
+    std::string pendingVertexCode;     ///< Sorgenti conservati per salvare il binario in ProgramCache
+    std::string pendingFragmentCode;
+    static bool parallelCompile;       ///< Il driver compila in parallelo (KHR_parallel_shader_compile)
+    std::vector<UniformSlot> uniformSlots; ///< Uniform attive del programma, indicizzate da UniformHandle
+    std::unordered_map<uint32_t, int> uniformIndex; ///< Hash del nome -> indice in uniformSlots
+
+public:
+    /// Nome del blocco uniform condiviso con i dati del frame (vedi Renderer::FrameData)
+    static constexpr const char* FRAME_DATA_BLOCK = "FrameData";
+
+    /// Binding point del blocco FrameData
+    static constexpr unsigned int FRAME_DATA_BINDING = 0;
+
+    Shader() = default;
+    Shader(const std::string& vertexShader, const std::string& fragmentShader, bool deferred = false);
+    ~Shader();
+
+    /**
+     * @brief Vero se compilazione e link sono conclusi e finishBuild() non bloccherà.
+     * Senza KHR_parallel_shader_compile è sempre vero.
+     */
+    bool isBuildComplete() const;
+
+    /// Legge l'esito di compilazione e link e rende lo shader utilizzabile (no-op se già fatto)
+    void finishBuild();
+
+    /// Vero finché l'esito della costruzione differita non è stato letto
+    bool isBuilding() const { return building; }
+
+    /**
+     * @brief Abilita la compilazione parallela del driver, se disponibile. Richiede un contesto attivo.
+     * @return true se KHR/ARB_parallel_shader_compile è supportata
+     */
+    static bool enableParallelCompile();
+    static bool hasParallelCompile() { return parallelCompile; }
+
+    /** @brief Attiva lo shader per il rendering (nessuna chiamata se è già attivo). */
+    void bind() const;
+
+    /** @brief Disattiva lo shader. */
+    void unbind();
+
+    /**
+     * @brief Risolve il nome di una uniform in un handle (nessuna chiamata OpenGL).
+     * Da fare una volta, fuori dal ciclo di disegno; l'handle non è valido se la uniform
+     * non esiste o è stata eliminata dal compilatore.
+     */
+    UniformHandle getUniformHandle(const UniformName& name) const;
+
+    // --- Uniform setters (per handle: percorso veloce) ---
+    void setUniformVec4(UniformHandle handle, const glm::vec4& vec);
+    void setUniformMat4(UniformHandle handle, const glm::mat4& matrix);
+    void setUniform1f(UniformHandle handle, float value);
+    void setUniformVec2(UniformHandle handle, const glm::vec2& vec);
+
+    // --- Uniform setters (per nome: risolvono l'handle a ogni chiamata) ---
+    void setUniform4f(const UniformName& name, float v0, float v1, float v2, float v3);
+    void setUniformVec4(const UniformName& name, const glm::vec4& vec);
+    void setUniformMat4(const UniformName& name, const glm::mat4& matrix);
+    void setUniform1f(const UniformName& name, float value);
+    void setUniformVec2(const UniformName& name, const glm::vec2& vec);
+
+    /** @return ID OpenGL dello shader. */
+    unsigned int getId() const { return rendererId; }
+
+    /** @return true se lo shader è valido, false altrimenti. */
+    bool isValid() const { return rendererId != 0; }
+
+private:
+    bool checkCompileStatus(unsigned int shader, const std::string& type);
+    void startBuild(const std::string& vertexCode, const std::string& fragmentCode);
+
+    /// Collega il blocco FrameData al suo binding point (dopo il link o il caricamento dalla cache)
+    static void bindFrameDataBlock(unsigned int program);
+
+    /// Elenca le uniform attive del programma linkato e ne crea gli slot
+    void registerUniforms();
+
+    /**
+     * @brief Confronta `data` con la copia dello slot e la aggiorna.
+     * @return true se la uniform va caricata (valore cambiato o mai caricato)
+     */
+    static bool updateShadow(UniformSlot& slot, const float* data, int size);
+};
@@ -1,45 +1,66 @@
-/**
- * @file ShaderManager.h
- * @brief Gestore centralizzato per la creazione e laccesso agli shader.
- */
-
-#pragma once
-#include <memory>
-#include <string>
-#include <unordered_map>
-
-class Shader;
-
-/**
- * @class ShaderManager
- * @brief Fornisce un meccanismo statico per caricare, gestire e recuperare shader.
- */
-class ShaderManager {
-public:
-    ShaderManager() = default;
-    ~ShaderManager() = default;
-
-    /**
-     * @brief Carica uno shader dai file sorgente e lo registra nel sistema.
-     * @param name Nome logico dello shader.
-     * @param vertexPath Percorso del file shader vertex.
-     * @param fragmentPath Percorso del file shader fragment.
-     * @return ID univoco assegnato allo shader.
-     */
-    static unsigned int load(const std::string& name, const std::string& vertexPath, const std::string& fragmentPath);
-
-    /** @brief Restituisce uno shader tramite nome. */
-    static std::shared_ptr<Shader> get(const std::string& name);
-
-    /** @brief Restituisce uno shader tramite ID. */
-    static std::shared_ptr<Shader> get(unsigned int id);
-
-    /** @brief Restituisce lID associato a un nome di shader. */
-    static unsigned int getId(const std::string& name);
-
-private:
-    static std::unordered_map<std::string, std::shared_ptr<Shader>> shadersMap; ///< Mappa nome ? Shader.
-    static std::unordered_map<unsigned int, std::shared_ptr<Shader>> idShadersMap; ///< Mappa ID ? Shader.
-    static std::unordered_map<std::string, unsigned int> nameToIdMap; ///< Mappa nome ? ID.
-    static unsigned int nextId; ///< Contatore per assegnare nuovi ID.
-};
+/**
+ * @file ShaderManager.h
+ * @brief Gestore centralizzato per la creazione e l’accesso agli shader.
+ */
+
+#pragma once
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Shader;
+
+/**
+ * @class ShaderManager
+ * @brief Fornisce un meccanismo statico per caricare, gestire e recuperare shader.
+ */
+class ShaderManager {
+public:
+    ShaderManager() = default;
+    ~ShaderManager() = default;
+
+    /**
+     * @brief Carica uno shader dai file sorgente e lo registra nel sistema.
+     * @param name Nome logico dello shader.
+     * @param vertexPath Percorso del file shader vertex.
+     * @param fragmentPath Percorso del file shader fragment.
+     * @return ID univoco assegnato allo shader.
+     */
+    static unsigned int load(const std::string& name, const std::string& vertexPath, const std::string& fragmentPath);
+
+    /**
+     * @brief Da qui in poi load() avvia compilazione e link senza attenderne l'esito.
+     *
+     * Gli ID restituiti sono validi subito, ma gli shader vanno usati solo dopo
+     * finishDeferredBuilds(): nel frattempo il driver compila mentre il chiamante
+     * prosegue con altro lavoro (es. generazione delle mesh).
+     */
+    static void beginDeferredBuilds();
+
+    /**
+     * @brief Completa tutti gli shader in sospeso, prima quelli già pronti, e torna al caricamento sincrono.
+     * @return Numero di shader completati
+     */
+    static unsigned int finishDeferredBuilds();
+
+    /** @brief Tutti gli shader registrati, per ID (es. per il warm-up). */
+    static const std::unordered_map<unsigned int, std::shared_ptr<Shader>>& getAll() { return idShadersMap; }
+
+    /** @brief Restituisce uno shader tramite nome. */
+    static std::shared_ptr<Shader> get(const std::string& name);
+
+    /** @brief Restituisce uno shader tramite ID. */
+    static std::shared_ptr<Shader> get(unsigned int id);
+
+    /** @brief Restituisce l’ID associato a un nome di shader. */
+    static unsigned int getId(const std::string& name);
+
+private:
+    static std::unordered_map<std::string, std::shared_ptr<Shader>> shadersMap; ///< Mappa nome ? Shader.
+    static std::unordered_map<unsigned int, std::shared_ptr<Shader>> idShadersMap; ///< Mappa ID ? Shader.
+    static std::unordered_map<std::string, unsigned int> nameToIdMap; ///< Mappa nome ? ID.
+    static unsigned int nextId; ///< Contatore per assegnare nuovi ID.
+    static bool deferBuilds; ///< load() non attende l'esito di compilazione e link
+    static std::vector<std::shared_ptr<Shader>> pendingBuilds; ///< Shader con costruzione in corso
+};
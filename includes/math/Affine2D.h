@@ -0,0 +1,98 @@
+#pragma once
+#include <cmath>
+#include <glm/glm.hpp>
+
+/**
+ * @struct Affine2D
+ * @brief Trasformazione affine 2D (matrice 3x2): rotazione/scala + traslazione.
+ *
+ * Il mondo di gioco è 2D, quindi una mat4 (16 float) è sovradimensionata: qui bastano
+ * 6 float, e comporre due trasformazioni costa 12 moltiplicazioni invece di 64.
+ *
+ * La matrice è memorizzata per colonne, come in GLM:
+ *
+ *     | x.x  y.x  t.x |
+ *     | x.y  y.y  t.y |
+ *
+ * La conversione in mat4 avviene solo al momento dell'upload verso la GPU (`toMat4`).
+ */
+struct Affine2D {
+    glm::vec2 x = glm::vec2(1.0f, 0.0f); ///< Prima colonna (immagine dell'asse X)
+    glm::vec2 y = glm::vec2(0.0f, 1.0f); ///< Seconda colonna (immagine dell'asse Y)
+    glm::vec2 t = glm::vec2(0.0f);       ///< Traslazione
+
+    /// Trasformazione identità
+    static Affine2D identity() { return Affine2D(); }
+
+    /// Sola traslazione
+    static Affine2D translation(const glm::vec2& offset) {
+        Affine2D m;
+        m.t = offset;
+        return m;
+    }
+
+    /// Sola scala (anche non uniforme)
+    static Affine2D scaling(const glm::vec2& factor) {
+        Affine2D m;
+        m.x = glm::vec2(factor.x, 0.0f);
+        m.y = glm::vec2(0.0f, factor.y);
+        return m;
+    }
+
+    /// Scala uniforme
+    static Affine2D scaling(float factor) { return scaling(glm::vec2(factor)); }
+
+    /**
+     * @brief Equivalente di translate * rotate(Z) * scale, con seno e coseno già calcolati.
+     */
+    static Affine2D fromTRS(const glm::vec2& position, float sinA, float cosA, const glm::vec2& scale) {
+        Affine2D m;
+        m.x = glm::vec2(cosA, sinA) * scale.x;
+        m.y = glm::vec2(-sinA, cosA) * scale.y;
+        m.t = position;
+        return m;
+    }
+
+    /// Equivalente di translate * rotate(Z) * scale
+    static Affine2D fromTRS(const glm::vec2& position, float angle, const glm::vec2& scale) {
+        return fromTRS(position, std::sin(angle), std::cos(angle), scale);
+    }
+
+    /**
+     * @brief Estrae la parte 2D di una mat4 (la componente Z viene ignorata).
+     */
+    static Affine2D fromMat4(const glm::mat4& m) {
+        Affine2D a;
+        a.x = glm::vec2(m[0].x, m[0].y);
+        a.y = glm::vec2(m[1].x, m[1].y);
+        a.t = glm::vec2(m[3].x, m[3].y);
+        return a;
+    }
+
+    /// Applica la trasformazione a un punto
+    glm::vec2 transformPoint(const glm::vec2& p) const { return x * p.x + y * p.y + t; }
+
+    /// Applica la trasformazione a un vettore (senza traslazione)
+    glm::vec2 transformVector(const glm::vec2& v) const { return x * v.x + y * v.y; }
+
+    /// Composizione: (this * rhs)(p) = this(rhs(p))
+    Affine2D operator*(const Affine2D& rhs) const {
+        Affine2D m;
+        m.x = transformVector(rhs.x);
+        m.y = transformVector(rhs.y);
+        m.t = transformPoint(rhs.t);
+        return m;
+    }
+
+    /**
+     * @brief Espande la trasformazione in una mat4 per gli shader.
+     * @param depth Traslazione lungo Z (profondità del layer)
+     */
+    glm::mat4 toMat4(float depth = 0.0f) const {
+        return glm::mat4(
+            glm::vec4(x, 0.0f, 0.0f),
+            glm::vec4(y, 0.0f, 0.0f),
+            glm::vec4(0.0f, 0.0f, 1.0f, 0.0f),
+            glm::vec4(t, depth, 1.0f));
+    }
+};
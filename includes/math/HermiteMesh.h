@@ -1,38 +1,76 @@
-#pragma once
-#include <vector>
-#include <string>
-#include <glm/glm.hpp>
-
-/**
- * @class HermiteMesh
- * @brief Genera mesh triangolate a partire da curve di Hermite o KochanekBartels.
- *
- * Questa classe fornisce funzioni per convertire una curva parametrica (Hermite o TBC)
- * in una mesh triangolata 2D, utilizzando lalgoritmo Earcut per la triangolazione.
- */
-class HermiteMesh {
-public:
-    /**
-     * @brief Genera una mesh triangolata a partire da una curva di Hermite chiusa.
-     * @param name Nome base della mesh.
-     * @param controlPoints Punti di controllo della curva.
-     * @param segmentsPerCurve Numero di segmenti per tratto.
-     * @return ID univoco della mesh registrata nel MeshManager, oppure 0 se fallisce.
-     */
-    static unsigned int baseHermiteToMesh(
-        const std::string& name,
-        const std::vector<glm::vec2>& controlPoints,
-        const int segmentsPerCurve = 40);
-
-    /**
-     * @brief Genera una mesh triangolata da una curva TBC (ex Catmull-Rom generalizzata).
-     * @param name Nome base della mesh.
-     * @param filePath Percorso del file contenente punti e parametri TBC.
-     * @param segmentsPerCurve Numero di segmenti per tratto.
-     * @return ID univoco della mesh registrata, oppure 0 se si verifica un errore.
-     */
-    static unsigned int catmullRomToMesh(
-        const std::string& name,
-        const std::string& filePath,
-        int segmentsPerCurve = 50);
-};
+#pragma once
+#include <vector>
+#include <string>
+#include <glm/glm.hpp>
+
+/**
+ * @brief Geometria tassellata sulla CPU, non ancora caricata su GPU.
+ *
+ * Prodotta da HermiteMesh::tessellateCatmullRom senza toccare OpenGL: può essere
+ * generata su un thread di lavoro e registrata in seguito sul thread del contesto.
+ */
+struct CurveMeshData {
+    std::vector<float> vertices;        ///< Posizioni x, y, z (z = 0)
+    std::vector<unsigned int> indices;  ///< Triangoli prodotti da Earcut
+    glm::vec2 min{ 0.0f };              ///< Angolo minimo dell'AABB
+    glm::vec2 max{ 0.0f };              ///< Angolo massimo dell'AABB
+    float boundingRadius = 0.0f;        ///< Raggio del cerchio di ingombro
+};
+
+/**
+ * @class HermiteMesh
+ * @brief Genera mesh triangolate a partire da curve di Hermite o Kochanek–Bartels.
+ *
+ * Questa classe fornisce funzioni per convertire una curva parametrica (Hermite o TBC)
+ * in una mesh triangolata 2D, utilizzando l’algoritmo Earcut per la triangolazione.
+ */
+class HermiteMesh {
+public:
+    /**
+     * @brief Genera una mesh triangolata a partire da una curva di Hermite chiusa.
+     * @param name Nome base della mesh.
+     * @param controlPoints Punti di controllo della curva.
+     * @param segmentsPerCurve Numero di segmenti per tratto.
+     * @return ID univoco della mesh registrata nel MeshManager, oppure 0 se fallisce.
+     */
+    static unsigned int baseHermiteToMesh(
+        const std::string& name,
+        const std::vector<glm::vec2>& controlPoints,
+        const int segmentsPerCurve = 40);
+
+    /**
+     * @brief Genera una mesh triangolata da una curva TBC (ex Catmull-Rom generalizzata).
+     * @param name Nome base della mesh.
+     * @param filePath Percorso del file contenente punti e parametri TBC.
+     * @param segmentsPerCurve Numero di segmenti per tratto.
+     * @return ID univoco della mesh registrata, oppure 0 se si verifica un errore.
+     */
+    static unsigned int catmullRomToMesh(
+        const std::string& name,
+        const std::string& filePath,
+        int segmentsPerCurve = 50);
+
+    /**
+     * @brief Fase CPU di catmullRomToMesh: lettura del file, curva TBC e triangolazione.
+     * Non usa OpenGL né il MeshManager, quindi è sicura da chiamare su un thread di lavoro.
+     * @param filePath Percorso del file contenente punti e parametri TBC.
+     * @param segmentsPerCurve Numero di segmenti per tratto.
+     * @param[out] data Geometria generata.
+     * @return false se il file non è leggibile o ha meno di due punti.
+     */
+    static bool tessellateCatmullRom(
+        const std::string& filePath,
+        int segmentsPerCurve,
+        CurveMeshData& data);
+
+    /**
+     * @brief Fase GPU di catmullRomToMesh: registra nel MeshManager una geometria già tassellata.
+     * Va chiamata sul thread che possiede il contesto OpenGL.
+     * @param name Nome base della mesh.
+     * @param data Geometria prodotta da tessellateCatmullRom.
+     * @return ID univoco della mesh registrata, oppure 0 se la geometria è vuota.
+     */
+    static unsigned int uploadCatmullRom(
+        const std::string& name,
+        const CurveMeshData& data);
+};
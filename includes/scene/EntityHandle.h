@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * @brief Riferimento leggero e copiabile a un'entità della Scene.
+ *
+ * È composto dall'indice dello slot nella tabella della scena e dalla generazione
+ * dello slot al momento della creazione. Quando l'entità viene distrutta la scena
+ * incrementa la generazione dello slot: un handle conservato dopo la distruzione
+ * non corrisponde più e viene riconosciuto come non valido (`Scene::getEntity`
+ * restituisce nullptr), anche se lo slot è stato riusato da un'altra entità.
+ */
+struct EntityHandle {
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    uint32_t index = INVALID_INDEX; ///< Slot nella tabella della scena
+    uint32_t generation = 0;        ///< Generazione dello slot al momento della creazione
+
+    /// Vero se l'handle è stato emesso da una scena (non dice se l'entità è ancora viva)
+    bool isSet() const { return index != INVALID_INDEX; }
+
+    bool operator==(const EntityHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
@@ -1,106 +1,258 @@
-#pragma once
-#include <vector>
-#include <memory>
-#include <random>
-#include <glad/glad.h>
-#include <glm/glm.hpp>
-#include <GLFW/glfw3.h>
-
-class Entity;
-class Renderer;
-
-/**
- * @class Scene
- * @brief Gestisce l'insieme di entit attive nel mondo di gioco e la loro interazione.
- *
- * La classe `Scene` rappresenta un contenitore logico per tutte le entit attualmente presenti
- * (player, proiettili, ostacoli, ecc.).  responsabile di:
- *  - aggiornare le entit nel tempo;
- *  - gestire lo spawning periodico di oggetti casuali (asteroidi/comete);
- *  - effettuare il rendering di ciascuna entit tramite il `Renderer`;
- *  - verificare le collisioni tra entit (proiettile-ostacolo e player-ostacolo);
- *  - mantenere un contatore delle collisioni avvenute.
- */
-class Scene {
-public:
-    Scene();
-    ~Scene() = default;
-
-    /**
-     * @brief Aggiunge una nuova entit alla scena.
-     * @param entity Puntatore condiviso all'entit da aggiungere.
-     */
-    void addEntity(const std::shared_ptr<Entity>& entity);
-
-    /**
-     * @brief Aggiorna tutte le entit attive e rimuove quelle non pi valide.
-     * @param deltaTime Intervallo di tempo trascorso (in secondi).
-     */
-    void update(float deltaTime);
-
-    /**
-     * @brief Esegue il rendering di tutte le entit attive nella scena.
-     * @param renderer Riferimento al renderer globale.
-     * @param mode Modalit OpenGL (es. GL_TRIANGLES, GL_LINE_LOOP, ecc.).
-     */
-    void render(Renderer& renderer, GLenum mode);
-
-    /**
-     * @brief Genera e aggiunge un proiettile alla scena.
-     *
-     * Il proiettile viene configurato con posizione, velocit, durata e dati di rendering.
-     *  pensato per essere richiamato dal motore di gioco o dal giocatore.
-     */
-    void spawnProjectile(const glm::vec2& position, const glm::vec2& velocity,
-        float lifetime, unsigned int meshId,
-        unsigned int shaderId, const glm::vec4& color);
-
-    /**
-     * @brief Rimuove tutte le entit dalla scena.
-     */
-    void clear();
-
-    /**
-     * @brief Gestisce lo spawning automatico e casuale di ostacoli (asteroidi o comete).
-     *
-     * Usa distribuzioni uniformi per decidere la posizione e il tipo di ostacolo.
-     * Gli oggetti vengono generati periodicamente in alto allo schermo e cadono verso il basso.
-     *
-     * @param deltaTime Tempo trascorso dall'ultimo frame.
-     * @param asteroidMeshId ID della mesh degli asteroidi.
-     * @param cometMeshId ID della mesh delle comete.
-     * @param shaderId ID dello shader usato per disegnare gli oggetti.
-     */
-    void updateSpawning(float deltaTime, unsigned int asteroidMeshId,
-        unsigned int cometMeshId, unsigned int shaderId);
-
-    /**
-     * @brief Verifica le collisioni tra entit rilevanti nella scena.
-     *
-     * - **Proiettili vs Ostacoli**: entrambi vengono disattivati e incrementa il contatore.
-     * - **Player vs Ostacoli**: l'ostacolo viene distrutto, il player subisce danno.
-     */
-    void checkCollisions();
-
-    /**
-     * @brief Restituisce tutte le entit correnti nella scena.
-     */
-    std::vector<std::shared_ptr<Entity>> getEntities() const { return entities; }
-
-    /**
-     * @brief Restituisce il numero di collisioni rilevate dall'ultimo frame.
-     * Il contatore viene azzerato dopo la lettura.
-     */
-    int getCollisions();
-
-private:
-    std::vector<std::shared_ptr<Entity>> entities; ///< Contenitore di tutte le entit attive.
-    float spawnCooldown = 1.0f; ///< Tempo minimo tra due spawn consecutivi.
-    float timeSinceLastSpawn = 0.0f; ///< Timer interno per lo spawning.
-    int numCollisions = 0; ///< Contatore temporaneo di collisioni rilevate.
-
-    // Generatore casuale per spawning
-    std::mt19937 randomEngine;
-    std::uniform_real_distribution<float> xDist = std::uniform_real_distribution<float>(-1.0f, 1.0f);
-    std::uniform_real_distribution<float> typeDist = std::uniform_real_distribution<float>(0.0f, 1.0f);
-};
+#pragma once
+#include <vector>
+#include <array>
+#include <memory>
+#include <random>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <GLFW/glfw3.h>
+#include "scene/SpatialGrid.h"
+#include "game/GameObject.h"
+#include "game/Projectile.h"
+#include "game/Obstacle.h"
+#include "utilities/ObjectPool.h"
+
+class Renderer;
+
+/**
+ * @brief Esito del culling dell'ultimo Scene::render.
+ * @param submitted Entità attive accodate nel renderer
+ * @param culled Entità attive scartate perché fuori dall'area visibile
+ */
+struct CullStats {
+    unsigned int submitted = 0;
+    unsigned int culled = 0;
+};
+
+/**
+ * @class Scene
+ * @brief Gestisce l'insieme di entità attive nel mondo di gioco e la loro interazione.
+ *
+ * La classe `Scene` rappresenta un contenitore logico per tutte le entità attualmente presenti
+ * (player, proiettili, ostacoli, ecc.). È responsabile di:
+ *  - aggiornare le entità nel tempo;
+ *  - gestire lo spawning periodico di oggetti casuali (asteroidi/comete);
+ *  - effettuare il rendering di ciascuna entità tramite il `Renderer`;
+ *  - verificare le collisioni tra entità (proiettile-ostacolo e player-ostacolo);
+ *  - mantenere un contatore delle collisioni avvenute.
+ *
+ * Le entità sono memorizzate in un bucket per ogni `EntityKind`: collisioni e rendering
+ * scorrono direttamente gli intervalli del tipo che serve, senza dynamic_cast né confronti
+ * sui nomi.
+ *
+ * Proiettili e ostacoli provengono da un ObjectPool per tipo: quando muoiono vengono
+ * restituiti al pool e riciclati dallo spawn successivo, senza allocazioni a regime.
+ * Le entità aggiunte con `addEntity` (es. il player) restano possedute dalla scena
+ * tramite shared_ptr.
+ *
+ * Ogni entità riceve un `EntityHandle` (indice + generazione) da una tabella di slot:
+ * il codice di gioco conserva gli handle e li risolve con `getEntity`. Le entità morte
+ * vengono accodate e rimosse a fine update con swap-and-pop dal loro bucket, quindi il
+ * costo della rimozione dipende solo dal numero di entità rimosse.
+ *
+ * L'update delle entità è parallelo sul JobSystem (vedi `update`).
+ */
+class Scene {
+public:
+    Scene();
+    ~Scene() = default;
+
+    /**
+     * @brief Aggiunge una nuova entità alla scena, nel bucket del suo `EntityKind`.
+     * @param entity Puntatore condiviso all'entità da aggiungere.
+     * @return Handle dell'entità (non valido se `entity` è nullo)
+     */
+    EntityHandle addEntity(const std::shared_ptr<Entity>& entity);
+
+    /**
+     * @brief Disattiva un'entità e la accoda per la rimozione a fine update().
+     *
+     * Handle non più validi vengono ignorati.
+     */
+    void destroyEntity(EntityHandle handle);
+
+    /**
+     * @brief Risolve un handle.
+     * @return L'entità, oppure nullptr se l'handle è scaduto (entità distrutta)
+     */
+    Entity* getEntity(EntityHandle handle) const;
+
+    /// Vero se l'handle si riferisce a un'entità ancora presente nella scena
+    bool isAlive(EntityHandle handle) const { return getEntity(handle) != nullptr; }
+
+    /**
+     * @brief Aggiorna tutte le entità attive e rimuove quelle non più valide.
+     *
+     * Le entità di ogni bucket vengono aggiornate in parallelo a blocchi: `Entity::update`
+     * non deve scrivere su altre entità né sulla scena.
+     * @param deltaTime Intervallo di tempo trascorso (in secondi).
+     */
+    void update(float deltaTime);
+
+    /// Entità per blocco dell'update parallelo
+    void setUpdateGrainSize(size_t grainSize) { updateGrainSize = grainSize > 0 ? grainSize : 1; }
+
+    /**
+     * @brief Accoda nel renderer le entità attive che intersecano l'area visibile.
+     *
+     * Il test usa l'AABB mondo in cache (`Entity::getAABB`), allargata di `CULL_MARGIN`
+     * per coprire lo spostamento dovuto all'interpolazione tra i passi di simulazione.
+     * Il player non viene accodato qui: è l'Engine ad accodarlo nel proprio layer, sopra
+     * le altre entità. Il disegno vero e proprio avviene in Renderer::flush.
+     * @param renderer Riferimento al renderer globale.
+     * @param visibleBounds Rettangolo di mondo visibile (vedi Camera::getVisibleBounds).
+     * @param mode Modalità OpenGL (es. GL_TRIANGLES, GL_LINE_LOOP, ecc.).
+     */
+    void render(Renderer& renderer, const AABB& visibleBounds, GLenum mode);
+
+    /// Abilita o disabilita il culling (disabilitato: tutte le entità attive vengono accodate)
+    void setCullingEnabled(bool enabled) { cullingEnabled = enabled; }
+    bool isCullingEnabled() const { return cullingEnabled; }
+
+    /// Entità accodate e scartate dall'ultimo render()
+    const CullStats& getCullStats() const { return cullStats; }
+
+    /// Margine (unità mondo) aggiunto all'area visibile nel test di culling
+    static constexpr float CULL_MARGIN = 0.05f;
+
+    /**
+     * @brief Genera e aggiunge un proiettile alla scena.
+     *
+     * Il proiettile viene configurato con posizione, velocità, durata e dati di rendering.
+     * È pensato per essere richiamato dal motore di gioco o dal giocatore.
+     * @return Handle del proiettile creato
+     */
+    EntityHandle spawnProjectile(const glm::vec2& position, const glm::vec2& velocity,
+        float lifetime, unsigned int meshId,
+        unsigned int shaderId, const glm::vec4& color);
+
+    /**
+     * @brief Genera e aggiunge un ostacolo alla scena, preso dal pool degli ostacoli.
+     *
+     * Usata da updateSpawning e dai benchmark.
+     * @param rotationSpeed Velocità di rotazione (usata solo dagli asteroidi)
+     * @return Handle dell'ostacolo creato
+     */
+    EntityHandle spawnObstacle(Obstacle::Type type, const glm::vec2& position,
+        const glm::vec2& velocity, float rotationSpeed, unsigned int meshId,
+        unsigned int shaderId, const glm::vec4& color);
+
+    /**
+     * @brief Rimuove tutte le entità dalla scena (quelle dei pool tornano disponibili).
+     */
+    void clear();
+
+    /**
+     * @brief Gestisce lo spawning automatico e casuale di ostacoli (asteroidi o comete).
+     *
+     * Usa distribuzioni uniformi per decidere la posizione e il tipo di ostacolo.
+     * Gli oggetti vengono generati periodicamente in alto allo schermo e cadono verso il basso.
+     *
+     * @param deltaTime Tempo trascorso dall'ultimo frame.
+     * @param asteroidMeshId ID della mesh degli asteroidi.
+     * @param cometMeshId ID della mesh delle comete.
+     * @param shaderId ID dello shader usato per disegnare gli oggetti.
+     */
+    void updateSpawning(float deltaTime, unsigned int asteroidMeshId,
+        unsigned int cometMeshId, unsigned int shaderId);
+
+    /**
+     * @brief Verifica le collisioni tra entità rilevanti nella scena.
+     *
+     * Gli ostacoli vengono inseriti in una griglia uniforme (broadphase): proiettili e player
+     * vengono confrontati solo con gli ostacoli che condividono almeno una cella.
+     *
+     * - **Proiettili vs Ostacoli**: entrambi vengono disattivati e incrementa il contatore.
+     * - **Player vs Ostacoli**: l'ostacolo viene distrutto, il player subisce danno.
+     */
+    void checkCollisions();
+
+    /**
+     * @brief Restituisce tutte le entità correnti nella scena (copia, uso di debug).
+     */
+    std::vector<Entity*> getEntities() const;
+
+    /**
+     * @brief Restituisce le entità di una sola categoria.
+     */
+    const std::vector<Entity*>& getEntities(EntityKind kind) const {
+        return buckets[static_cast<size_t>(kind)];
+    }
+
+    /**
+     * @brief Restituisce il numero di collisioni rilevate dall'ultimo frame.
+     * Il contatore viene azzerato dopo la lettura.
+     */
+    int getCollisions();
+
+    /**
+     * @brief Restituisce la griglia usata come broadphase per le collisioni.
+     */
+    SpatialGrid& getBroadphase() { return broadphase; }
+
+    /// Statistiche del pool dei proiettili
+    const ObjectPoolStats& getProjectilePoolStats() const { return projectilePool.getStats(); }
+
+    /// Statistiche del pool degli ostacoli
+    const ObjectPoolStats& getObstaclePoolStats() const { return obstaclePool.getStats(); }
+
+private:
+    using EntityBucket = std::vector<Entity*>;
+
+    /// Accesso in scrittura al bucket di una categoria
+    EntityBucket& bucket(EntityKind kind) { return buckets[static_cast<size_t>(kind)]; }
+
+    /// Chi possiede la memoria di un'entità registrata
+    enum class EntityOwner : uint8_t {
+        Shared,         ///< shared_ptr in ownedEntities
+        ProjectilePool, ///< projectilePool
+        ObstaclePool    ///< obstaclePool
+    };
+
+    /**
+     * @brief Slot della tabella degli handle.
+     * @param entity Entità che occupa lo slot (nullptr se libero)
+     * @param generation Incrementata a ogni rimozione: invalida gli handle precedenti
+     * @param denseIndex Posizione dell'entità nel suo bucket
+     * @param owner Proprietario a cui restituire l'entità quando viene rimossa
+     */
+    struct EntitySlot {
+        Entity* entity = nullptr;
+        uint32_t generation = 1;
+        uint32_t denseIndex = 0;
+        EntityOwner owner = EntityOwner::Shared;
+    };
+
+    /// Assegna uno slot all'entità e la inserisce nel bucket della sua categoria
+    EntityHandle registerEntity(Entity* entity, EntityOwner owner);
+
+    /// Toglie l'entità dal bucket (swap-and-pop), libera lo slot e la restituisce al proprietario
+    void removeEntity(Entity* entity);
+
+    /// Rimuove le entità accodate in pendingDestroy
+    void flushDestroyed();
+
+    /// Restituisce un'entità morta al suo proprietario (pool o lista degli shared_ptr)
+    void releaseEntity(Entity* entity, EntityOwner owner);
+
+    std::array<EntityBucket, static_cast<size_t>(EntityKind::Count)> buckets; ///< Entità attive, una lista per categoria.
+    std::vector<EntitySlot> slots;            ///< Tabella degli handle, indicizzata da EntityHandle::index.
+    std::vector<uint32_t> freeSlots;          ///< Slot liberi da riutilizzare.
+    std::vector<EntityHandle> pendingDestroy; ///< Entità da rimuovere alla fine di update().
+    std::vector<std::vector<EntityHandle>> workerDeadLists; ///< Entità morte durante l'update, una lista per worker.
+    size_t updateGrainSize = 256;             ///< Entità per blocco dell'update parallelo.
+    bool cullingEnabled = true;               ///< Scarta in render() le entità fuori dall'area visibile.
+    CullStats cullStats;                      ///< Esito del culling dell'ultimo render().
+    std::vector<std::shared_ptr<Entity>> ownedEntities; ///< Entità aggiunte dall'esterno con addEntity.
+    ObjectPool<Projectile> projectilePool{ 64, 64 }; ///< Proiettili riciclabili.
+    ObjectPool<Obstacle> obstaclePool{ 32, 32 };     ///< Asteroidi e comete riciclabili.
+    float spawnCooldown = 1.0f; ///< Tempo minimo tra due spawn consecutivi.
+    float timeSinceLastSpawn = 0.0f; ///< Timer interno per lo spawning.
+    int numCollisions = 0; ///< Contatore temporaneo di collisioni rilevate.
+    SpatialGrid broadphase; ///< Griglia uniforme degli ostacoli, ricostruita a ogni checkCollisions().
+
+    // Generatore casuale per spawning
+    std::mt19937 randomEngine;
+    std::uniform_real_distribution<float> xDist = std::uniform_real_distribution<float>(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> typeDist = std::uniform_real_distribution<float>(0.0f, 1.0f);
+};
@@ -0,0 +1,69 @@
+#pragma once
+#include <vector>
+
+/**
+ * @brief Risultato di una singola misura della broadphase.
+ * @param entityCount Numero totale di entità simulate (metà proiettili, metà ostacoli)
+ * @param gridMs Tempo in millisecondi di build + query della griglia uniforme
+ * @param bruteForceMs Tempo del confronto O(P×O) originale (-1 se saltato)
+ * @param collidingPairs Coppie proiettile-ostacolo in collisione trovate dalla griglia
+ */
+struct BroadphaseBenchmarkResult {
+    int entityCount = 0;
+    double gridMs = 0.0;
+    double bruteForceMs = -1.0;
+    int collidingPairs = 0;
+};
+
+/**
+ * @brief Risultato di una misura dell'update parallelo della scena.
+ * @param threadCount Worker del JobSystem usati (thread principale incluso)
+ * @param updateMs Tempo medio di uno Scene::update in millisecondi
+ * @param speedup Rapporto rispetto alla prima misura (di norma 1 thread)
+ */
+struct ParallelUpdateBenchmarkResult {
+    unsigned threadCount = 0;
+    double updateMs = 0.0;
+    double speedup = 1.0;
+};
+
+/**
+ * @class SceneBenchmark
+ * @brief Micro-benchmark dei sistemi della scena, richiamabili dall'editor.
+ *
+ * Le misure usano dati sintetici (nessuna chiamata OpenGL), così da isolare
+ * il costo della logica della scena dal rendering.
+ */
+class SceneBenchmark {
+public:
+    /**
+     * @brief Misura la broadphase a griglia uniforme al crescere del numero di entità.
+     *
+     * Le entità sono distribuite in un mondo la cui area cresce con il loro numero,
+     * così che la densità resti costante: con una broadphase lineare il tempo per
+     * entità deve rimanere circa costante fino a 50k entità.
+     *
+     * @param entityCounts Numeri di entità da misurare
+     * @param bruteForceLimit Oltre questa soglia il confronto O(P×O) non viene eseguito
+     * @return Un risultato per ogni elemento di entityCounts
+     */
+    static std::vector<BroadphaseBenchmarkResult> runBroadphase(
+        const std::vector<int>& entityCounts = { 1000, 5000, 10000, 25000, 50000 },
+        int bruteForceLimit = 10000);
+
+    /**
+     * @brief Misura Scene::update con molti ostacoli in movimento al variare dei worker.
+     *
+     * Per ogni numero di thread il JobSystem viene reinizializzato; alla fine torna al
+     * numero di worker che aveva prima della chiamata. I numeri di thread superiori ai
+     * core disponibili vengono saltati.
+     *
+     * @param threadCounts Numeri di worker da misurare
+     * @param entityCount Ostacoli nella scena di prova
+     * @param meshId Mesh degli ostacoli (usata per il calcolo dei bound, come in gioco)
+     * @return Un risultato per ogni numero di thread misurato
+     */
+    static std::vector<ParallelUpdateBenchmarkResult> runParallelUpdate(
+        const std::vector<unsigned>& threadCounts = { 1, 2, 4, 8 },
+        int entityCount = 100000, unsigned int meshId = 0);
+};
@@ -0,0 +1,119 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "game/Collision.h"
+
+/**
+ * @class SpatialGrid
+ * @brief Griglia uniforme (spatial hash) usata come broadphase per le collisioni.
+ *
+ * Lo spazio 2D viene suddiviso in celle quadrate di lato `cellSize`. Ogni elemento
+ * inserito viene registrato in tutte le celle coperte dalla sua AABB: una query
+ * restituisce quindi solo gli elementi che condividono almeno una cella con il box cercato.
+ *
+ * La griglia viene ricostruita ogni frame con un counting sort sui bucket:
+ *  - il costo è lineare nel numero di elementi inseriti;
+ *  - i vettori interni vengono riutilizzati, quindi a regime non ci sono allocazioni.
+ *
+ * Le celle vengono mappate su un numero limitato di bucket tramite hash, per cui
+ * una query può restituire anche elementi di celle diverse: il test esatto resta
+ * a carico di `AABB::isColliding`.
+ */
+class SpatialGrid {
+public:
+    /**
+     * @brief Costruttore.
+     * @param cellSize Lato di una cella in unità mondo
+     */
+    explicit SpatialGrid(float cellSize = 0.5f);
+
+    /// Imposta il lato delle celle (ha effetto dal prossimo build())
+    void setCellSize(float size);
+
+    /// Restituisce il lato delle celle
+    float getCellSize() const { return cellSize; }
+
+    /// Svuota la griglia mantenendo la memoria già allocata
+    void clear();
+
+    /**
+     * @brief Registra un elemento nella griglia.
+     *
+     * L'indice dell'elemento corrisponde all'ordine di inserimento (0, 1, 2, ...)
+     * ed è quello restituito dalle query.
+     *
+     * @param box AABB dell'elemento in coordinate mondo
+     */
+    void insert(const AABB& box);
+
+    /**
+     * @brief Distribuisce gli elementi registrati nei bucket.
+     * Va chiamato dopo gli insert() e prima delle query.
+     */
+    void build();
+
+    /**
+     * @brief Invoca `callback(index)` per ogni elemento che condivide una cella con `box`.
+     *
+     * Ogni elemento viene riportato al massimo una volta per query.
+     */
+    template<typename Callback>
+    void query(const AABB& box, Callback&& callback) const;
+
+    /// Restituisce l'AABB registrata per l'elemento `index`
+    const AABB& getBox(uint32_t index) const { return boxes[index]; }
+
+    /// Numero di elementi inseriti
+    size_t getItemCount() const { return boxes.size(); }
+
+private:
+    /// Intervallo di celle (estremi inclusi) coperto da un'AABB
+    struct CellRange {
+        int minX, minY, maxX, maxY;
+    };
+
+    CellRange cellRange(const AABB& box) const;
+    uint32_t bucketOf(int cellX, int cellY) const;
+
+    float cellSize;
+    float invCellSize;
+
+    std::vector<AABB> boxes;              ///< AABB degli elementi, indicizzate per ordine di inserimento
+    std::vector<uint32_t> bucketStart;    ///< Prefix sum: inizio di ogni bucket in bucketItems
+    std::vector<uint32_t> bucketItems;    ///< Indici degli elementi ordinati per bucket
+    std::vector<uint32_t> writeCursor;    ///< Cursori di scrittura usati durante build()
+    uint32_t bucketMask = 0;              ///< Numero di bucket - 1 (potenza di due)
+    size_t cellEntries = 0;               ///< Coppie (elemento, cella) registrate
+
+    // Marcatori per evitare di riportare due volte lo stesso elemento in una query
+    mutable std::vector<uint32_t> visitStamp;
+    mutable uint32_t currentStamp = 0;
+};
+
+template<typename Callback>
+void SpatialGrid::query(const AABB& box, Callback&& callback) const {
+    if (boxes.empty() || bucketStart.empty() || box.min.x > box.max.x || box.min.y > box.max.y) {
+        return;
+    }
+
+    // Nuovo marcatore per questa query (reset completo al wrap-around)
+    if (++currentStamp == 0) {
+        std::fill(visitStamp.begin(), visitStamp.end(), 0u);
+        currentStamp = 1;
+    }
+
+    const CellRange range = cellRange(box);
+    for (int cy = range.minY; cy <= range.maxY; ++cy) {
+        for (int cx = range.minX; cx <= range.maxX; ++cx) {
+            const uint32_t bucket = bucketOf(cx, cy);
+            for (uint32_t i = bucketStart[bucket]; i < bucketStart[bucket + 1]; ++i) {
+                const uint32_t index = bucketItems[i];
+                if (visitStamp[index] != currentStamp) {
+                    visitStamp[index] = currentStamp;
+                    callback(index);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+/**
+ * @brief Statistiche di utilizzo di un ObjectPool, mostrate nell'editor.
+ * @param capacity Oggetti allocati in totale (liberi + in uso)
+ * @param inUse Oggetti attualmente consegnati dal pool
+ * @param peakInUse Massimo di oggetti in uso contemporaneamente
+ * @param chunkCount Blocchi allocati (ogni blocco oltre il primo è una crescita)
+ * @param acquireCount Numero totale di acquire() (riusi + nuovi)
+ */
+struct ObjectPoolStats {
+    size_t capacity = 0;
+    size_t inUse = 0;
+    size_t peakInUse = 0;
+    size_t chunkCount = 0;
+    size_t acquireCount = 0;
+};
+
+/**
+ * @class ObjectPool
+ * @brief Pool di oggetti a blocchi con free-list, per riciclare entità senza allocazioni.
+ *
+ * Gli oggetti vengono costruiti una sola volta (costruttore di default) in blocchi di
+ * `chunkSize` elementi e non vengono mai distrutti finché il pool esiste:
+ *  - `acquire()` restituisce un oggetto dalla free-list, che il chiamante deve reinizializzare;
+ *  - `release()` lo rimette nella free-list mantenendo la memoria che possiede (es. vettori).
+ *
+ * Se la free-list è vuota viene allocato un nuovo blocco: a regime, dimensionando bene
+ * la capacità iniziale, non avvengono allocazioni. Gli indirizzi restano stabili.
+ */
+template<typename T>
+class ObjectPool {
+public:
+    /**
+     * @brief Costruttore.
+     * @param chunkSize Numero di oggetti allocati a ogni crescita
+     * @param initialCapacity Oggetti da preallocare subito
+     */
+    explicit ObjectPool(size_t chunkSize = 64, size_t initialCapacity = 0)
+        : chunkSize(chunkSize > 0 ? chunkSize : 1) {
+        reserve(initialCapacity);
+    }
+
+    // Il pool possiede gli oggetti: niente copie
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /// Preleva un oggetto libero (allocando un blocco se necessario)
+    T* acquire() {
+        if (freeList.empty()) {
+            grow();
+        }
+
+        T* obj = freeList.back();
+        freeList.pop_back();
+
+        stats.acquireCount++;
+        stats.inUse++;
+        if (stats.inUse > stats.peakInUse) stats.peakInUse = stats.inUse;
+        return obj;
+    }
+
+    /// Restituisce un oggetto al pool (deve provenire da questo pool)
+    void release(T* obj) {
+        freeList.push_back(obj);
+        stats.inUse--;
+    }
+
+    /// Vero se `obj` appartiene a uno dei blocchi di questo pool
+    bool owns(const T* obj) const {
+        for (const auto& chunk : chunks) {
+            if (obj >= chunk.get() && obj < chunk.get() + chunkSize) return true;
+        }
+        return false;
+    }
+
+    /// Garantisce che il pool possa contenere almeno `capacity` oggetti
+    void reserve(size_t capacity) {
+        while (stats.capacity < capacity) {
+            grow();
+        }
+    }
+
+    const ObjectPoolStats& getStats() const { return stats; }
+
+private:
+    /// Alloca un nuovo blocco e ne inserisce gli oggetti nella free-list
+    void grow() {
+        chunks.emplace_back(new T[chunkSize]);
+        stats.capacity += chunkSize;
+        stats.chunkCount++;
+
+        // Riserva subito lo spazio per tutti gli oggetti: release() non alloca mai
+        freeList.reserve(stats.capacity);
+        T* chunk = chunks.back().get();
+        for (size_t i = chunkSize; i > 0; --i) {
+            freeList.push_back(&chunk[i - 1]);
+        }
+    }
+
+    size_t chunkSize;
+    std::vector<std::unique_ptr<T[]>> chunks; ///< Blocchi di oggetti (indirizzi stabili)
+    std::vector<T*> freeList;                  ///< Oggetti disponibili
+    ObjectPoolStats stats;
+};
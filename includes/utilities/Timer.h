@@ -1,68 +1,181 @@
-#pragma once
-#include <GLFW/glfw3.h>
-#include <thread>
-#include <chrono>
-
-namespace Timer {
-
-    static constexpr double TARGET_FPS = 60.0;
-    static constexpr double FRAME_DURATION = 1.0 / TARGET_FPS; // 0.0166667 s (16.67 ms)
-
-    static double totalTime = 0.0;
-    static double lastFrameTime = 0.0;
-    static float deltaTime = 0.0f;
-
-    /**
-     * @brief Inizializza il timer.
-     */
-    inline void init() {
-        lastFrameTime = glfwGetTime();
-        totalTime = 0.0;
-        deltaTime = 0.0f;
-    }
-
-    /**
-     * @brief Aggiorna il timer e blocca il frame per mantenere 60 FPS.
-     *
-     * Chiama questa funzione all'inizio di ogni iterazione del game loop.
-     * Restituisce il tempo effettivo passato (deltaTime).
-     */
-    inline void update() {
-        double currentTime = glfwGetTime();
-        double elapsed = currentTime - lastFrameTime;
-
-        // Se il frame  pi veloce del previsto, aspetta per arrivare a 60 FPS
-        if (elapsed < FRAME_DURATION) {
-            double sleepTime = FRAME_DURATION - elapsed;
-            std::this_thread::sleep_for(std::chrono::duration<double>(sleepTime));
-            currentTime = glfwGetTime();
-            elapsed = currentTime - lastFrameTime;
-        }
-
-        lastFrameTime = currentTime;
-        totalTime += elapsed;
-        deltaTime = static_cast<float>(elapsed);
-    }
-
-    /**
-     * @brief Restituisce il tempo trascorso tra due frame consecutivi.
-     */
-    inline float getDeltaTime() {
-        return deltaTime;
-    }
-
-    /**
-     * @brief Restituisce il tempo totale trascorso dall'avvio in secondi.
-     */
-    inline float getTotalTime() {
-        return static_cast<float>(totalTime);
-    }
-
-    /**
-     * @brief Restituisce il frame rate effettivo (per debug).
-     */
-    inline float getCurrentFPS() {
-        return 1.0f / deltaTime;
-    }
-
-}
+#pragma once
+#include <GLFW/glfw3.h>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Gestione del tempo del game loop: frame di rendering e passi di simulazione.
+ *
+ * Il rendering e la simulazione sono disaccoppiati (fixed timestep):
+ *  - ogni frame `update()` misura il tempo reale trascorso e lo accumula;
+ *  - `stepSimulation()` consuma l'accumulatore a passi fissi di `getFixedDeltaTime()`,
+ *    al massimo `maxCatchUpSteps` volte per frame (i passi in eccesso vengono scartati,
+ *    così il costo della simulazione resta limitato anche sotto carico);
+ *  - `getInterpolationAlpha()` indica quanto il frame corrente si trova tra l'ultimo
+ *    passo e il successivo, per interpolare le trasformazioni in fase di rendering.
+ *
+ * Il frame rate del rendering è indipendente: può essere libero, limitato da V-Sync
+ * o limitato da `setFrameRateCap`.
+ */
+namespace Timer {
+
+    /**
+     * @brief Stato condiviso del timer.
+     *
+     * Vive in una variabile statica locale di una funzione inline, così tutte le
+     * translation unit vedono la stessa istanza.
+     */
+    struct State {
+        double totalTime = 0.0;        ///< Tempo reale dall'avvio (secondi)
+        double lastFrameTime = 0.0;    ///< Istante dell'ultimo update()
+        float deltaTime = 0.0f;        ///< Durata dell'ultimo frame di rendering
+
+        double simulationHz = 60.0;    ///< Frequenza dei passi di simulazione
+        int maxCatchUpSteps = 5;       ///< Passi massimi per frame
+        double frameRateCap = 0.0;     ///< FPS massimi del rendering (0 = nessun limite)
+
+        double accumulator = 0.0;      ///< Tempo non ancora simulato
+        int stepsThisFrame = 0;        ///< Passi eseguiti nel frame corrente
+        int lastFrameSteps = 0;        ///< Passi eseguiti nel frame precedente
+        unsigned long long droppedSteps = 0; ///< Passi scartati per il limite di catch-up
+    };
+
+    inline State& state() {
+        static State s;
+        return s;
+    }
+
+    /**
+     * @brief Inizializza il timer.
+     */
+    inline void init() {
+        State& s = state();
+        s.lastFrameTime = glfwGetTime();
+        s.totalTime = 0.0;
+        s.deltaTime = 0.0f;
+        s.accumulator = 0.0;
+        s.stepsThisFrame = 0;
+        s.lastFrameSteps = 0;
+        s.droppedSteps = 0;
+    }
+
+    /**
+     * @brief Imposta la frequenza della simulazione (passi al secondo).
+     */
+    inline void setSimulationRate(double hz) {
+        state().simulationHz = std::max(1.0, hz);
+    }
+
+    /**
+     * @brief Imposta il numero massimo di passi di simulazione per frame.
+     */
+    inline void setMaxCatchUpSteps(int steps) {
+        state().maxCatchUpSteps = std::max(1, steps);
+    }
+
+    /**
+     * @brief Limita il frame rate del rendering (0 = nessun limite).
+     */
+    inline void setFrameRateCap(double fps) {
+        state().frameRateCap = std::max(0.0, fps);
+    }
+
+    /**
+     * @brief Aggiorna il timer e accumula il tempo da simulare.
+     *
+     * Chiama questa funzione all'inizio di ogni iterazione del game loop.
+     * Se è impostato un limite di FPS, attende fino alla durata minima del frame.
+     */
+    inline void update() {
+        State& s = state();
+        double currentTime = glfwGetTime();
+        double elapsed = currentTime - s.lastFrameTime;
+
+        // Se il frame è più veloce del limite impostato, aspetta
+        if (s.frameRateCap > 0.0) {
+            const double frameDuration = 1.0 / s.frameRateCap;
+            if (elapsed < frameDuration) {
+                std::this_thread::sleep_for(std::chrono::duration<double>(frameDuration - elapsed));
+                currentTime = glfwGetTime();
+                elapsed = currentTime - s.lastFrameTime;
+            }
+        }
+
+        s.lastFrameTime = currentTime;
+        s.totalTime += elapsed;
+        s.deltaTime = static_cast<float>(elapsed);
+
+        s.accumulator += elapsed;
+        s.lastFrameSteps = s.stepsThisFrame;
+        s.stepsThisFrame = 0;
+    }
+
+    /**
+     * @brief Restituisce la durata fissa di un passo di simulazione.
+     */
+    inline float getFixedDeltaTime() {
+        return static_cast<float>(1.0 / state().simulationHz);
+    }
+
+    /**
+     * @brief Consuma un passo di simulazione dall'accumulatore.
+     *
+     * Da usare come condizione di un ciclo: `while (Timer::stepSimulation()) { ... }`.
+     * Raggiunto il limite di passi per frame, i passi interi residui vengono scartati.
+     *
+     * @return true se va eseguito un passo di simulazione
+     */
+    inline bool stepSimulation() {
+        State& s = state();
+        const double step = 1.0 / s.simulationHz;
+
+        if (s.accumulator < step) {
+            return false;
+        }
+
+        // Limite raggiunto: si scartano i passi interi rimasti, mantenendo la frazione
+        if (s.stepsThisFrame >= s.maxCatchUpSteps) {
+            s.droppedSteps += static_cast<unsigned long long>(s.accumulator / step);
+            s.accumulator = std::fmod(s.accumulator, step);
+            return false;
+        }
+
+        s.accumulator -= step;
+        s.stepsThisFrame++;
+        return true;
+    }
+
+    /**
+     * @brief Frazione di passo non ancora simulata, in [0, 1).
+     * Usata per interpolare tra lo stato precedente e quello corrente.
+     */
+    inline float getInterpolationAlpha() {
+        const State& s = state();
+        return static_cast<float>(std::min(1.0, s.accumulator * s.simulationHz));
+    }
+
+    /**
+     * @brief Restituisce il tempo trascorso tra due frame consecutivi.
+     */
+    inline float getDeltaTime() {
+        return state().deltaTime;
+    }
+
+    /**
+     * @brief Restituisce il tempo totale trascorso dall'avvio in secondi.
+     */
+    inline float getTotalTime() {
+        return static_cast<float>(state().totalTime);
+    }
+
+    /**
+     * @brief Restituisce il frame rate effettivo (per debug).
+     */
+    inline float getCurrentFPS() {
+        const float dt = state().deltaTime;
+        return dt > 0.0f ? 1.0f / dt : 0.0f;
+    }
+
+}
@@ -1,19 +1,25 @@
-#version 330 core
-layout (location = 0) in vec2 aPos; // Coordinate di posizione del vertice
-
-out vec2 vUV; // Variabile passata al Fragment Shader (coordinate del quad)
-
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-void main()
-{
-    // 1. Trasformazione standard del vertice
-    // Questo sposta il quad nello spazio 3D e lo proietta sullo schermo.
-    gl_Position = projection * view * model * vec4(aPos, 0.0, 1.0);
-    
-    // Queste coordinate servono al Fragment Shader per calcolare il rumore/stelle
-    // in modo coerente indipendentemente dalla posizione del quad sulla scena.
-    vUV = aPos; 
+#version 330 core
+layout (location = 0) in vec2 aPos; // Coordinate di posizione del vertice
+
+out vec2 vUV; // Variabile passata al Fragment Shader (coordinate del quad)
+
+uniform mat4 model;
+// Dati del frame condivisi (Renderer::FrameData, binding point 0)
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec2 uResolution;
+    float uTime;
+};
+
+void main()
+{
+    // 1. Trasformazione standard del vertice
+    // Questo sposta il quad nello spazio 3D e lo proietta sullo schermo.
+    gl_Position = projection * view * model * vec4(aPos, 0.0, 1.0);
+    
+    // Queste coordinate servono al Fragment Shader per calcolare il rumore/stelle
+    // in modo coerente indipendentemente dalla posizione del quad sulla scena.
+    // Con le posizioni quantizzate (GeometryArena) aPos è già normalizzato sui bound del quad: [-1, 1].
+    vUV = aPos; 
 }
\ No newline at end of file
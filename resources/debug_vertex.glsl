@@ -0,0 +1,19 @@
+#version 330 core
+
+layout(location = 0) in vec2 aPos;   // posizione mondo del vertice
+layout(location = 1) in vec4 aColor; // colore della primitiva di debug
+
+// Dati del frame condivisi (Renderer::FrameData, binding point 0)
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec2 uResolution;
+    float uTime;
+};
+
+out vec4 vColor;
+
+void main() {
+    gl_Position = projection * view * vec4(aPos, 0.0, 1.0);
+    vColor = aColor;
+}
@@ -1,7 +1,7 @@
-#version 330 core
-out vec4 FragColor;
-uniform vec4 uColor;
-
-void main() {
-    FragColor = uColor;
-}
+#version 330 core
+out vec4 FragColor;
+uniform vec4 uColor;
+
+void main() {
+    FragColor = uColor;
+}
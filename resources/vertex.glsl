@@ -1,11 +1,16 @@
-#version 330 core
-
-layout(location = 0) in vec3 aPos;
-
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-void main() {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
-}
+#version 330 core
+
+layout(location = 0) in vec2 aPos; // float o short normalizzato (vedi GeometryArena)
+
+uniform mat4 model;
+// Dati del frame condivisi (Renderer::FrameData, binding point 0)
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec2 uResolution;
+    float uTime;
+};
+
+void main() {
+    gl_Position = projection * view * model * vec4(aPos, 0.0, 1.0);
+}
@@ -0,0 +1,24 @@
+#version 330 core
+
+layout(location = 0) in vec2 aPos; // float o short normalizzato (vedi GeometryArena)
+
+// Attributi per istanza (glVertexAttribDivisor = 1)
+layout(location = 1) in vec4 iLinear;      // colonne x (xy) e y (zw) della trasformazione 2D
+layout(location = 2) in vec4 iTranslation; // traslazione (xy) e profondità (z)
+layout(location = 3) in vec4 iColor;
+
+// Dati del frame condivisi (Renderer::FrameData, binding point 0)
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec2 uResolution;
+    float uTime;
+};
+
+out vec4 vColor;
+
+void main() {
+    vec2 worldPos = iLinear.xy * aPos.x + iLinear.zw * aPos.y + iTranslation.xy;
+    gl_Position = projection * view * vec4(worldPos, iTranslation.z, 1.0);
+    vColor = iColor;
+}
@@ -1,526 +1,653 @@
-#include "core/Engine.h"
-
-#include <memory>
-#include <glad/glad.h>
-#include <GLFW/glfw3.h>
-#include <stdexcept>
-
-#include "core/InputManager.h"
-#include "core/Window.h"
-#include "graphics/Vertex.h"
-#include "graphics/Shader.h"
-#include "graphics/Camera.h"
-#include "graphics/Mesh.h"
-#include "graphics/Renderer.h"
-#include "game/SpaceCleaner.h"
-#include "utilities/Utilities.h"
-#include "utilities/Timer.h"
-#include "scene/Scene.h"
-#include "math/HermiteMesh.h"
-#include "graphics/ShaderManager.h"
-#include "graphics/MeshManager.h"
-#include "ui/ImGuiManager.h"
-#include "game/Collision.h"
-#include "math/CatmullRom.h"
-#include "core/BackGround.h"
-#include "core/PlayerConfig.h"
-#include "core/ResourceLoader.h"
-
-// Costruttore e distruttore
-Engine::Engine() {}
-Engine::~Engine() {}
-
-
-/**
- * Applica una configurazione visiva al giocatore
- * @param configIndex Indice della configurazione da applicare (0-based)
- *
- * Ogni configurazione contiene 3 layer visivi:
- * - Base: struttura principale della nave
- * - Livery: decorazione/livrea
- * - Cockpit: cabina di pilotaggio
- */
-void Engine::applyPlayerConfig(unsigned int configIndex) {
-    // Verifica validit: player esistente e indice valido
-    if (!player || configIndex >= playerConfigs.size()) {
-        return;
-    }
-
-    const auto& config = playerConfigs[configIndex];
-
-    // Rimuove tutti i layer visivi precedenti
-    player->clearMeshLayers();
-
-    // --- LAYER 1: BASE ---
-    // Struttura principale della navicella
-    SubMeshRenderInfo baseLayer(config.baseMeshId, this->defaultShaderId, config.base.color);
-    baseLayer.localTransform = config.base.localTransform;
-    player->addMeshLayer(baseLayer);
-
-    // --- LAYER 2: LIVERY ---
-    // Decorazioni e pattern della nave
-    SubMeshRenderInfo liveryLayer(config.liveryMeshId, this->defaultShaderId, config.livery.color);
-    liveryLayer.localTransform = config.livery.localTransform;
-    player->addMeshLayer(liveryLayer);
-
-    // --- LAYER 3: COCKPIT ---
-    // Cabina di pilotaggio
-    SubMeshRenderInfo cockpitLayer(config.cockpitMeshId, this->defaultShaderId, config.cockpit.color);
-    cockpitLayer.localTransform = config.cockpit.localTransform;
-    player->addMeshLayer(cockpitLayer);
-
-    // Sincronizza la selezione con l'interfaccia ImGui
-    imguiManager->currentPlayerSelection = configIndex;
-}
-
-/**
- * Processa tutti gli input dell'utente con logica gerarchica basata sullo stato
- *
- * Priorit:
- * 1. Tasti di sistema (ESC, F1)
- * 2. Tasti di stato (R per reset, SPACE per start)
- * 3. Controlli di gioco (movimento, sparo)
- */
-void Engine::processInput() {
-
-    // --- ESC: Pausa/Riprendi/Esci ---
-    if (InputManager::isKeyPressed(GLFW_KEY_ESCAPE) && timeSinceLastEsc >= escCooldown) {
-        timeSinceLastEsc = 0.0f;
-
-        if (currentState == GameState::PLAYING) {
-            // Durante il gioco: metti in pausa
-            currentState = GameState::PAUSED;
-        }
-        else if (currentState == GameState::PAUSED) {
-            // In pausa: riprendi il gioco
-            currentState = GameState::PLAYING;
-        }
-        else if (currentState == GameState::START) {
-            // Nel menu iniziale: chiudi il gioco
-            window->setShouldClose(true);
-        }
-        // NOTA: in GAME_OVER, ESC non fa nulla (usa R per resettare)
-        return;
-    }
-
-    // --- F1: Toggle Debug/Editor UI ---
-    if (InputManager::isKeyPressed(GLFW_KEY_F1) && timeSinceLastF1 >= f1Cooldown) {
-        imguiVisible = !imguiVisible;
-        timeSinceLastF1 = 0.0f;
-    }
-
-    if (currentState == GameState::GAME_OVER) {
-        // R: Resetta e riavvia il gioco
-        if (InputManager::isKeyPressed(GLFW_KEY_R)) {
-            resetGame();
-        }
-        // Blocca tutti gli altri input durante GAME_OVER
-        return;
-    }
-
-    if (currentState == GameState::START || currentState == GameState::PAUSED) {
-        // SPACE nel menu START: avvia il gioco
-        if (currentState == GameState::START && InputManager::isKeyPressed(GLFW_KEY_SPACE)) {
-            currentState = GameState::PLAYING;
-            resetGame(); // Resetta salute e punteggio
-            return;
-        }
-        // Blocca tutti gli input di gioco in START e PAUSED
-        return;
-    }
-
-	// CONTROLLI DI GIOCO (solo in PLAYING)
-
-    // --- MOVIMENTO TRASLAZIONALE ---
-    if (InputManager::isKeyPressed(GLFW_KEY_W))
-        player->transform.translate({ 0.0f, 0.02f });   // Su
-
-    if (InputManager::isKeyPressed(GLFW_KEY_S))
-        player->transform.translate({ 0.0f, -0.02f });  // Gi
-
-    if (InputManager::isKeyPressed(GLFW_KEY_A))
-        player->transform.translate({ -0.02f, 0.0f });  // Sinistra
-
-    if (InputManager::isKeyPressed(GLFW_KEY_D))
-        player->transform.translate({ 0.02f, 0.0f });   // Destra
-
-    // --- MOVIMENTO ROTAZIONALE ---
-    if (InputManager::isKeyPressed(GLFW_KEY_Q))
-        player->transform.rotate(0.06f);   // Ruota in senso antiorario
-
-    if (InputManager::isKeyPressed(GLFW_KEY_E))
-        player->transform.rotate(-0.06f);  // Ruota in senso orario
-
-    // --- SPARO PROIETTILI ---
-    if (InputManager::isKeyPressed(GLFW_KEY_SPACE)) {
-        // Cooldown per evitare sparo continuo
-        if (timeSinceLastShot >= fireCooldown) {
-            timeSinceLastShot = 0.0f;
-
-            // Calcola posizione e direzione del proiettile
-            glm::vec2 shipPos = player->transform.getPosition();
-            float angle = player->transform.getRotation();
-
-            // Direzione basata sull'angolo di rotazione della nave
-            glm::vec2 dir = glm::vec2(-sin(angle), cos(angle));
-
-            // Parametri del proiettile
-            float speed = 1.2f;
-            glm::vec2 vel = dir * speed;
-            float lifetime = 3.0f;  // Secondi prima della distruzione
-
-            // Spawna il proiettile nella scena
-            if (scene)
-                scene->spawnProjectile(shipPos, vel, lifetime,
-                    this->projectileMeshId,
-                    this->defaultShaderId,
-                    glm::vec4(1.0f, 0.8f, 0.2f, 1.0f));  // Colore giallo-arancione
-        }
-    }
-}
-
-/**
- * Aggiorna la logica di gioco ogni frame
- * @param delta Tempo trascorso dall'ultimo frame (in secondi)
- */
-void Engine::update(float delta) {
-    // Aggiorna i timer di cooldown
-    timeSinceLastF1 += delta;
-    timeSinceLastEsc += delta;
-
-    // Controlla se l'utente ha cambiato nave nell'editor
-    if (imguiManager->currentPlayerSelection < playerConfigs.size()) {
-        static unsigned int lastPlayerSelection = imguiManager->currentPlayerSelection;
-        if (imguiManager->currentPlayerSelection != lastPlayerSelection) {
-            applyPlayerConfig(imguiManager->currentPlayerSelection);
-            lastPlayerSelection = imguiManager->currentPlayerSelection;
-        }
-    }
-
-    // Non aggiornare la logica se non in PLAYING
-    if (currentState == GameState::GAME_OVER ||
-        currentState == GameState::PAUSED ||
-        currentState == GameState::START) {
-        return;
-    }
-
-	// Aggiornamento timer sparo
-    timeSinceLastShot += delta;
-
-	// Aggiornamento scena di gioco
-    if (scene) {
-        // Aggiorna fisica ed entit
-        scene->update(delta);
-
-        // Rileva e gestisce collisioni
-        scene->checkCollisions();
-
-        // Incrementa punteggio per ogni collisione (100 punti)
-        scoreManager.adjustScore(scene->getCollisions() * 100);
-
-        // Se ha 0 cuori -> Game Over
-        if (player->getHealth() == 0) {
-            currentState = GameState::GAME_OVER;
-        }
-
-        // Spawna nuovi nemici (asteroidi, comete)
-        scene->updateSpawning(delta,
-            this->asteroidMeshId,
-            this->cometMeshId,
-            this->defaultShaderId);
-    }
-}
-
-/**
- * Renderizza un frame completo del gioco
- *
- * Ordine di rendering:
- * 1. Background animato
- * 2. Entit di gioco (nemici, proiettili)
- * 3. Player
- * 4. UI (cuori, bounding box debug)
- * 5. ImGui (editor, menu)
- */
-void Engine::rendering() {
-    if (!window) {
-        return;
-    }
-
-    // Pulisce il buffer dello schermo
-    renderer->clear();
-
-	// BACKGROUND ANIMATO
-
-    // Calcola l'aspect ratio per lo sfondo
-    float orthoWidth = camera->getWidth() / camera->getHeight();
-    glm::mat4 bgModel = glm::scale(glm::mat4(1.0f), glm::vec3(orthoWidth, 1.0f, 1.0f));
-    glm::mat4 viewIdentity = glm::mat4(1.0f);
-
-    // Aggiorna lo shader di background se cambiato dall'utente
-    if (imguiManager->currentBackgroundSelection < backgroundConfigs.size()) {
-        unsigned int selectedId = backgroundConfigs[imguiManager->currentBackgroundSelection].shaderId;
-
-        if (selectedId != this->backgroundShaderId) {
-            this->backgroundShaderId = selectedId;
-        }
-    }
-
-    // Recupera e configura lo shader del background
-    std::shared_ptr<Shader> backgroundShader = ShaderManager::get(this->backgroundShaderId);
-    if (backgroundShader) {
-        renderer->setCamera(viewIdentity, camera->getProjectionMatrix());
-        backgroundShader->bind();
-
-        // Passa parametri per animazione shader
-        backgroundShader->setUniformVec2("uResolution",
-            glm::vec2(window->getWidth(), window->getHeight()));
-        backgroundShader->setUniform1f("uTime", Timer::getTotalTime());
-
-        // Matrici di trasformazione
-        backgroundShader->setUniformMat4("view", viewIdentity);
-        backgroundShader->setUniformMat4("projection", camera->getProjectionMatrix());
-        backgroundShader->setUniformMat4("model", bgModel);
-
-        // Colore base del background
-        backgroundShader->setUniformVec4("uColor", glm::vec4(0.05f, 0.05f, 0.1f, 1.0f));
-
-        // Disegna la mesh del background
-        auto mesh = MeshManager::getById(this->backgroundMeshId);
-        if (mesh) {
-            mesh->draw(*backgroundShader, GL_TRIANGLES);
-        }
-
-        backgroundShader->unbind();
-    }
-
-    // ENTIT DI GIOCO
-
-    renderer->setCamera(viewIdentity, camera->getProjectionMatrix());
-
-    // Renderizza tutti i nemici e proiettili
-    if (scene)
-        scene->render(*renderer, GL_TRIANGLES);
-
-
-    // PLAYER e CUORI
-
-    if (player) {
-        // Disegna la navicella del giocatore
-        float worldLeft = -(camera->getWidth() / camera->getHeight());
-        renderer->drawEntityByInfo(*player, GL_TRIANGLES);
-
-		// Disegna i cuori della salute in alto a sinistra
-        glm::vec2 startPos = glm::vec2(worldLeft + 0.05f, 1.0f - 0.05f);  // Angolo in alto a sinistra
-        float spacing = 0.08f;      // Distanza tra cuori
-        float heartScale = 0.1f;    // Dimensione cuori
-
-        int currentHealth = player->getHealth();
-        int maxHealth = player->getMaxHealth();
-
-        // Disegna i cuori (pieni = salute, vuoti = salute persa)
-        for (int i = 0; i < maxHealth; ++i) {
-            // Colore: rosso pieno se attivo, grigio trasparente se vuoto
-            glm::vec4 color = (i < currentHealth) ?
-                glm::vec4(1.0f, 0.0f, 0.4f, 1.0f) :      // Rosa acceso
-                glm::vec4(0.3f, 0.3f, 0.3f, 0.5f);       // Grigio trasparente
-
-            // Posiziona e scala il cuore
-            glm::mat4 model = glm::mat4(1.0f);
-            model = glm::translate(model, glm::vec3(startPos.x + i * spacing, startPos.y, 0.0f));
-            model = glm::scale(model, glm::vec3(heartScale));
-
-            // Renderizza il cuore
-            renderer->drawMesh(
-                this->heartMeshId,
-                this->defaultShaderId,
-                color,
-                model,
-                GL_TRIANGLES
-            );
-        }
-    }
-
-    // DEBUG: BOUNDING BOX
-
-    // Mostra i bounding box per debug collisioni
-    if (imguiManager->boundingBoxMode) {
-        if (scene) {
-            for (const auto& entity : scene->getEntities()) {
-                AABB box = entity->getAABB();
-                renderer->drawBoundingBox(box, glm::vec4(0.0f, 1.0f, 0.0f, 1.0f),
-                    viewIdentity, camera->getProjectionMatrix());
-            }
-        }
-    }
-
-    // INTERFACCIA IMGUI
-
-    // Mostra ImGui se visibile o se non in gioco
-    if (imguiVisible || currentState != GameState::PLAYING) {
-        imguiManager->beginFrame();
-
-        // Editor/Debug UI
-        if (imguiVisible) {
-            imguiManager->drawEditorWindow(this);
-        }
-
-        // Menu contestuali basati sullo stato
-        if (currentState == GameState::START) {
-            imguiManager->drawStartMenu(this);
-        }
-        else if (currentState == GameState::PAUSED) {
-            imguiManager->drawPauseMenu(this);
-        }
-        else if (currentState == GameState::GAME_OVER) {
-            imguiManager->drawGameOverMenu(this);
-        }
-
-        imguiManager->endFrame();
-    }
-
-    // Aggiorna il buffer della finestra (swap buffers)
-    window->updateWindow();
-}
-
-/**
- * Resetta il gioco allo stato iniziale
- * - Ripristina salute del player
- * - Azzera punteggio
- * - Torna allo stato PLAYING
- */
-void Engine::resetGame() {
-    currentState = PLAYING;
-    player->resetHealth();
-    scoreManager.reset();
-}
-
-/**
- * Loop principale del gioco (60 FPS)
- * La funzione  un'implementazione del game loop pattern.
- * 
- * Pattern:
- * 1. Aggiorna timer e calcola deltaTime
- * 2. Processa eventi finestra
- * 3. Gestisci input
- * 4. Aggiorna logica
- * 5. Renderizza
- */
-void Engine::gameLoop() {
-    Timer::init(); // Inizializza il sistema di timing
-
-    while (window->windowIsOpen()) {
-        Timer::update();                  // Lock a 60 FPS
-        float delta = Timer::getDeltaTime();
-
-        window->pollEvents();             // Eventi GLFW (resize, close, etc.)
-        processInput();                   // Input utente
-        update(delta);                    // Logica di gioco
-        rendering();                      // Rendering
-    }
-}
-
-// INIZIALIZZAZIONE
-
-/**
- * Inizializza l'intero engine
- *
- * Setup:
- * 1. Contesto OpenGL/GLFW
- * 2. Finestra e camera
- * 3. Renderer e input
- * 4. ImGui
- * 5. Caricamento risorse (shader, mesh, configurazioni)
- * 6. Creazione player e scene
- */
-void Engine::init() {
-	// Configurazione GLFW per OpenGL 3.3 Core Profile
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-    glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
-
-	// Creazione finestra di gioco
-    int width = 1000;
-    int height = 800;
-    window = std::make_unique<Window>(width, height);
-
-    camera = std::make_unique<Camera>(width, height);
-    renderer = std::make_unique<Renderer>();
-
-    // Callback per aggiornare la proiezione quando la finestra cambia dimensione
-    window->setResizeCallback([this](int newWidth, int newHeight) {
-        if (camera) {
-            camera->setProjection(newWidth, newHeight);
-        }
-        });
-
-	// Inizializza InputManager e l'API di ImGUI con il riferimento alla finestra GLFW
-    InputManager::init(window->getWindowReference());
-    imguiManager = std::make_unique<ImGuiManager>(window->getWindowReference());
-    scene = std::make_unique<Scene>();
-
-    // Abilita blending per trasparenza
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    
-    // CARICAMENTO RISORSE
-
-    // Usa ResourceLoader per caricare shader, mesh e configurazioni
-    ResourceLoader resourceLoader;
-    resourceLoader.loadAllResources(
-        this->defaultShaderId,
-        this->projectileMeshId,
-        this->heartMeshId,
-        this->backgroundMeshId,
-        this->playerConfigs,
-        this->backgroundConfigs
-    );
-
-	/**
-    * CREAZIONE PLAYER E MESH PERSONALIZZATE
-    * In questa sezione ho voluto far vedere un dettaglio implementativo.
-    * Inizialmente le entit venivano create con mesh interne al codice.
-	* Ho intenzionalmente mantenuto questa parte per mostrare il processo di creazione
-    * e di evoluzione in termini di design della creazione di una mesh.
-    */
-    player = std::make_shared<SpaceCleaner>("SpaceCleaner", this);
-
-    // --- ASTEROIDE ---
-    // Forma irregolare con 7 punti di controllo
-    std::vector<glm::vec2> asteroidPoints = {
-        glm::vec2(0.2f, 0.4f),
-        glm::vec2(0.6f, 0.2f),
-        glm::vec2(0.3f, -0.1f),
-        glm::vec2(0.5f, -0.4f),
-        glm::vec2(-0.2f, -0.5f),
-        glm::vec2(-0.6f, -0.1f),
-        glm::vec2(-0.4f, 0.3f)
-    };
-    asteroidMeshId = HermiteMesh::baseHermiteToMesh("AsteroidShape", asteroidPoints, 40);
-
-    // --- COMETA ---
-    // Forma allungata con 6 punti di controllo
-    std::vector<glm::vec2> cometPoints = {
-        glm::vec2(0.0f, 0.6f),
-        glm::vec2(0.1f, 0.3f),
-        glm::vec2(0.15f, 0.0f),
-        glm::vec2(0.0f, -0.1f),
-        glm::vec2(-0.15f, 0.0f),
-        glm::vec2(-0.1f, 0.3f)
-    };
-    cometMeshId = HermiteMesh::baseHermiteToMesh("CometShape", cometPoints, 30);
-
-
-    // Imposta lo shader di background iniziale
-    if (!backgroundConfigs.empty()) {
-        this->backgroundShaderId = backgroundConfigs[0].shaderId;
-        imguiManager->currentBackgroundSelection = 0;
-    }
-
-    // Aggiungi il player alla scena
-    scene->addEntity(player);
-
-    // Applica la configurazione iniziale del player (Modello 1, indice 0)
-    applyPlayerConfig(0);
+#include "core/Engine.h"
+
+#include <memory>
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <stdexcept>
+
+#include "core/InputManager.h"
+#include "core/Window.h"
+#include "graphics/Vertex.h"
+#include "graphics/Shader.h"
+#include "graphics/Camera.h"
+#include "graphics/Mesh.h"
+#include "graphics/Renderer.h"
+#include "graphics/BackgroundPass.h"
+#include "graphics/DynamicResolution.h"
+#include "game/SpaceCleaner.h"
+#include "utilities/Utilities.h"
+#include "utilities/Timer.h"
+#include "scene/Scene.h"
+#include "math/HermiteMesh.h"
+#include "graphics/ShaderManager.h"
+#include "graphics/MeshManager.h"
+#include "graphics/GLStateCache.h"
+#include "ui/ImGuiManager.h"
+#include "game/Collision.h"
+#include "math/CatmullRom.h"
+#include "core/BackGround.h"
+#include "core/PlayerConfig.h"
+#include "core/ResourceLoader.h"
+#include "core/JobSystem.h"
+
+// Costruttore e distruttore
+Engine::Engine() {}
+Engine::~Engine() {
+    resourceLoader.reset(); // Attende la tassellazione in corso prima di fermare i worker
+    JobSystem::shutdown();
+}
+
+/**
+ * Risolve l'handle del player tramite la scena.
+ * Restituisce nullptr se la scena non è ancora stata creata o l'handle è scaduto.
+ */
+SpaceCleaner* Engine::getPlayer() const {
+    if (!scene) return nullptr;
+    return static_cast<SpaceCleaner*>(scene->getEntity(playerHandle));
+}
+
+
+/**
+ * Applica una configurazione visiva al giocatore
+ * @param configIndex Indice della configurazione da applicare (0-based)
+ *
+ * Ogni configurazione contiene 3 layer visivi:
+ * - Base: struttura principale della nave
+ * - Livery: decorazione/livrea
+ * - Cockpit: cabina di pilotaggio
+ *
+ * Le trasformazioni della configurazione sono mat4: qui se ne estrae la parte 2D,
+ * mentre l'offset Z diventa la profondità del layer.
+ *
+ * Le mesh di un modello mai usato vengono caricate alla prima selezione. Se la
+ * tassellazione è ancora in corso, la nave attuale resta come segnaposto e update()
+ * riprova a ogni frame finché il modello non è pronto.
+ */
+void Engine::applyPlayerConfig(unsigned int configIndex) {
+    SpaceCleaner* player = getPlayer();
+
+    // Verifica validità: player esistente e indice valido
+    if (!player || configIndex >= playerConfigs.size()) {
+        return;
+    }
+
+    auto& config = playerConfigs[configIndex];
+
+    // Sincronizza la selezione con l'interfaccia ImGui
+    imguiManager->currentPlayerSelection = configIndex;
+
+    if (!resourceLoader->preparePlayerMeshes(config, configIndex, false)) {
+        pendingPlayerConfig = static_cast<int>(configIndex);
+        return;
+    }
+    pendingPlayerConfig = -1;
+
+    // Rimuove tutti i layer visivi precedenti
+    player->clearMeshLayers();
+
+    // --- LAYER 1: BASE ---
+    // Struttura principale della navicella
+    SubMeshRenderInfo baseLayer(config.baseMeshId, this->defaultShaderId, config.base.color);
+    baseLayer.localTransform = Affine2D::fromMat4(config.base.localTransform);
+    baseLayer.depth = config.base.localTransform[3].z;
+    player->addMeshLayer(baseLayer);
+
+    // --- LAYER 2: LIVERY ---
+    // Decorazioni e pattern della nave
+    SubMeshRenderInfo liveryLayer(config.liveryMeshId, this->defaultShaderId, config.livery.color);
+    liveryLayer.localTransform = Affine2D::fromMat4(config.livery.localTransform);
+    liveryLayer.depth = config.livery.localTransform[3].z;
+    player->addMeshLayer(liveryLayer);
+
+    // --- LAYER 3: COCKPIT ---
+    // Cabina di pilotaggio
+    SubMeshRenderInfo cockpitLayer(config.cockpitMeshId, this->defaultShaderId, config.cockpit.color);
+    cockpitLayer.localTransform = Affine2D::fromMat4(config.cockpit.localTransform);
+    cockpitLayer.depth = config.cockpit.localTransform[3].z;
+    player->addMeshLayer(cockpitLayer);
+}
+
+/**
+ * Processa tutti gli input dell'utente con logica gerarchica basata sullo stato
+ *
+ * Priorità:
+ * 1. Tasti di sistema (ESC, F1)
+ * 2. Tasti di stato (R per reset, SPACE per start)
+ * 3. Controlli di gioco (movimento, sparo)
+ */
+void Engine::processInput() {
+
+    // --- ESC: Pausa/Riprendi/Esci ---
+    if (InputManager::isKeyPressed(GLFW_KEY_ESCAPE) && timeSinceLastEsc >= escCooldown) {
+        timeSinceLastEsc = 0.0f;
+
+        if (currentState == GameState::PLAYING) {
+            // Durante il gioco: metti in pausa
+            currentState = GameState::PAUSED;
+        }
+        else if (currentState == GameState::PAUSED) {
+            // In pausa: riprendi il gioco
+            currentState = GameState::PLAYING;
+        }
+        else if (currentState == GameState::START) {
+            // Nel menu iniziale: chiudi il gioco
+            window->setShouldClose(true);
+        }
+        // NOTA: in GAME_OVER, ESC non fa nulla (usa R per resettare)
+        return;
+    }
+
+    // --- F1: Toggle Debug/Editor UI ---
+    if (InputManager::isKeyPressed(GLFW_KEY_F1) && timeSinceLastF1 >= f1Cooldown) {
+        imguiVisible = !imguiVisible;
+        timeSinceLastF1 = 0.0f;
+    }
+
+    if (currentState == GameState::GAME_OVER) {
+        // R: Resetta e riavvia il gioco
+        if (InputManager::isKeyPressed(GLFW_KEY_R)) {
+            resetGame();
+        }
+        // Blocca tutti gli altri input durante GAME_OVER
+        return;
+    }
+
+    if (currentState == GameState::START || currentState == GameState::PAUSED) {
+        // SPACE nel menu START: avvia il gioco
+        if (currentState == GameState::START && InputManager::isKeyPressed(GLFW_KEY_SPACE)) {
+            currentState = GameState::PLAYING;
+            resetGame(); // Resetta salute e punteggio
+            return;
+        }
+        // Blocca tutti gli input di gioco in START e PAUSED
+        return;
+    }
+
+	// CONTROLLI DI GIOCO (solo in PLAYING)
+    SpaceCleaner* player = getPlayer();
+    if (!player) return;
+
+    // L'input imposta solo direzione e verso di rotazione: lo spostamento vero e proprio
+    // (velocità * dt) avviene nei passi fissi di simulazione, indipendenti dal frame rate.
+
+    // --- MOVIMENTO TRASLAZIONALE ---
+    glm::vec2 moveDir(0.0f);
+    if (InputManager::isKeyPressed(GLFW_KEY_W))
+        moveDir.y += 1.0f;   // Su
+
+    if (InputManager::isKeyPressed(GLFW_KEY_S))
+        moveDir.y -= 1.0f;   // Giù
+
+    if (InputManager::isKeyPressed(GLFW_KEY_A))
+        moveDir.x -= 1.0f;   // Sinistra
+
+    if (InputManager::isKeyPressed(GLFW_KEY_D))
+        moveDir.x += 1.0f;   // Destra
+
+    player->setDirection(moveDir != glm::vec2(0.0f) ? glm::normalize(moveDir) : moveDir);
+
+    // --- MOVIMENTO ROTAZIONALE ---
+    float turn = 0.0f;
+    if (InputManager::isKeyPressed(GLFW_KEY_Q))
+        turn += 1.0f;   // Ruota in senso antiorario
+
+    if (InputManager::isKeyPressed(GLFW_KEY_E))
+        turn -= 1.0f;   // Ruota in senso orario
+
+    player->setTurnDirection(turn);
+
+    // --- SPARO PROIETTILI ---
+    if (InputManager::isKeyPressed(GLFW_KEY_SPACE)) {
+        // Cooldown per evitare sparo continuo
+        if (timeSinceLastShot >= fireCooldown) {
+            timeSinceLastShot = 0.0f;
+
+            // Calcola posizione e direzione del proiettile
+            glm::vec2 shipPos = player->transform.getPosition();
+            float angle = player->transform.getRotation();
+
+            // Direzione basata sull'angolo di rotazione della nave
+            glm::vec2 dir = glm::vec2(-sin(angle), cos(angle));
+
+            // Parametri del proiettile
+            float speed = 1.2f;
+            glm::vec2 vel = dir * speed;
+            float lifetime = 3.0f;  // Secondi prima della distruzione
+
+            // Spawna il proiettile nella scena
+            if (scene)
+                scene->spawnProjectile(shipPos, vel, lifetime,
+                    this->projectileMeshId,
+                    this->defaultShaderId,
+                    glm::vec4(1.0f, 0.8f, 0.2f, 1.0f));  // Colore giallo-arancione
+        }
+    }
+}
+
+/**
+ * Aggiorna lo stato legato al frame (cooldown dei tasti, selezione dall'editor)
+ * @param delta Tempo trascorso dall'ultimo frame (in secondi)
+ */
+void Engine::update(float delta) {
+    // Aggiorna i timer di cooldown
+    timeSinceLastF1 += delta;
+    timeSinceLastEsc += delta;
+
+    // Controlla se l'utente ha cambiato nave nell'editor
+    if (imguiManager->currentPlayerSelection < playerConfigs.size()) {
+        static unsigned int lastPlayerSelection = imguiManager->currentPlayerSelection;
+        if (imguiManager->currentPlayerSelection != lastPlayerSelection) {
+            applyPlayerConfig(imguiManager->currentPlayerSelection);
+            lastPlayerSelection = imguiManager->currentPlayerSelection;
+        }
+    }
+
+    // Nave scelta prima che le sue mesh fossero pronte: la applica appena lo sono
+    if (pendingPlayerConfig >= 0) {
+        applyPlayerConfig(static_cast<unsigned int>(pendingPlayerConfig));
+    }
+}
+
+/**
+ * Esegue un passo di simulazione a durata fissa
+ * @param dt Durata del passo (Timer::getFixedDeltaTime)
+ */
+void Engine::fixedUpdate(float dt) {
+    // Non aggiornare la logica se non in PLAYING
+    if (currentState == GameState::GAME_OVER ||
+        currentState == GameState::PAUSED ||
+        currentState == GameState::START) {
+        return;
+    }
+
+	// Aggiornamento timer sparo
+    timeSinceLastShot += dt;
+
+	// Aggiornamento scena di gioco
+    if (scene) {
+        // Aggiorna fisica ed entità
+        scene->update(dt);
+
+        // Rileva e gestisce collisioni
+        scene->checkCollisions();
+
+        // Incrementa punteggio per ogni collisione (100 punti)
+        scoreManager.adjustScore(scene->getCollisions() * 100);
+
+        // Se ha 0 cuori -> Game Over
+        SpaceCleaner* player = getPlayer();
+        if (player && player->getHealth() == 0) {
+            currentState = GameState::GAME_OVER;
+        }
+
+        // Spawna nuovi nemici (asteroidi, comete)
+        scene->updateSpawning(dt,
+            this->asteroidMeshId,
+            this->cometMeshId,
+            this->defaultShaderId);
+    }
+}
+
+/**
+ * Disegna lo sfondo animato tramite il BackgroundPass.
+ *
+ * A piena risoluzione il quad viene posto a RenderQueue::BACKGROUND_DEPTH con depth test
+ * attivo e scrittura disabilitata: va chiamato dopo la passata opaca. A risoluzione ridotta
+ * viene disegnato nell'FBO del passo (senza profondità) e riportato nella scena con un blit.
+ */
+void Engine::drawBackground(int renderWidth, int renderHeight) {
+    // Calcola l'aspect ratio per lo sfondo
+    float orthoWidth = camera->getWidth() / camera->getHeight();
+    const float backgroundDepth = RenderQueue::BACKGROUND_DEPTH;
+    glm::mat4 bgModel = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, backgroundDepth));
+    bgModel = glm::scale(bgModel, glm::vec3(orthoWidth, 1.0f, 1.0f));
+
+    // Recupera e configura lo shader del background.
+    // Il passo disegna nel framebuffer ridotto solo quando va rigenerato, poi lo ingrandisce nella scena
+    std::shared_ptr<Shader> backgroundShader = ShaderManager::get(this->backgroundShaderId);
+    if (backgroundPass->begin(renderWidth, renderHeight, this->backgroundShaderId) && backgroundShader) {
+        const bool offscreen = backgroundPass->isOffscreen();
+        GLStateCache::setDepthTest(!offscreen);
+        GLStateCache::setDepthWrite(false);
+
+        // Gli shader di sfondo usano gl_FragCoord / uResolution: la risoluzione è quella dell'FBO
+        const glm::ivec2 targetSize = backgroundPass->getTargetSize();
+        if (offscreen)
+            renderer->updateFrameData(glm::vec2(targetSize), Timer::getTotalTime());
+
+        backgroundShader->bind();
+
+        // Camera, risoluzione e tempo arrivano dal blocco FrameData
+        auto mesh = MeshManager::getById(this->backgroundMeshId);
+        if (mesh) bgModel = bgModel * mesh->getDequantization().toMat4();
+        backgroundShader->setUniformMat4(uniforms::Model, bgModel);
+
+        // Colore base del background
+        backgroundShader->setUniformVec4(uniforms::Color, glm::vec4(0.05f, 0.05f, 0.1f, 1.0f));
+
+        // Disegna la mesh del background
+        if (mesh) {
+            mesh->draw(*backgroundShader, GL_TRIANGLES);
+        }
+
+        backgroundShader->unbind();
+
+        if (offscreen)
+            renderer->updateFrameData(glm::vec2(renderWidth, renderHeight), Timer::getTotalTime());
+    }
+    backgroundPass->end(dynamicResolution->getTarget(), renderWidth, renderHeight);
+}
+
+/**
+ * Renderizza un frame completo del gioco
+ *
+ * Ordine di invio (il disegno segue le passate del renderer):
+ * 1. Entità di gioco (nemici, proiettili)
+ * 2. Player
+ * 3. UI (cuori, bounding box debug)
+ * 4. Passata opaca, background animato al piano più lontano, passata trasparente
+ *    (a risoluzione ridotta il background viene invece copiato per primo)
+ * 5. Composizione della scena a dimensione finestra (risoluzione dinamica)
+ * 6. ImGui (editor, menu)
+ */
+void Engine::rendering() {
+    if (!window) {
+        return;
+    }
+
+    // Nuovo frame: azzera i contatori del renderer, collega la destinazione della scena
+    // (schermo o render target a risoluzione dinamica) e la pulisce
+    const int screenWidth = window->getWidth();
+    const int screenHeight = window->getHeight();
+    renderer->beginFrame();
+    dynamicResolution->begin(screenWidth, screenHeight);
+    renderer->clear();
+    const glm::ivec2 renderSize = dynamicResolution->getRenderSize();
+
+    // Interpolazione tra gli ultimi due passi di simulazione (solo mentre la simulazione avanza)
+    renderer->setInterpolationAlpha(currentState == GameState::PLAYING ? Timer::getInterpolationAlpha() : 1.0f);
+
+    // Dati condivisi del frame (camera, risoluzione, tempo): un solo upload per tutti gli shader
+    glm::mat4 viewIdentity = glm::mat4(1.0f);
+    renderer->setCamera(viewIdentity, camera->getProjectionMatrix());
+    renderer->updateFrameData(glm::vec2(renderSize), Timer::getTotalTime());
+
+    // Aggiorna lo shader di background se cambiato dall'utente
+    if (imguiManager->currentBackgroundSelection < backgroundConfigs.size()) {
+        unsigned int selectedId = backgroundConfigs[imguiManager->currentBackgroundSelection].shaderId;
+
+        if (selectedId != this->backgroundShaderId) {
+            this->backgroundShaderId = selectedId;
+        }
+    }
+
+    // Lo sfondo disegnato direttamente va dopo gli opachi, al piano più lontano, così i pixel
+    // coperti dalle entità vengono scartati dal depth test prima del fragment shader.
+    // Quello a risoluzione ridotta arriva con un blit, che ignora il depth test: va per primo.
+    const bool backgroundLast = !backgroundPass->isOffscreen();
+    if (!backgroundLast)
+        drawBackground(renderSize.x, renderSize.y);
+
+    // ENTITÀ DI GIOCO
+
+    // Accoda tutti i nemici e proiettili (il disegno avviene nelle passate del renderer)
+    if (scene)
+        scene->render(*renderer, camera->getVisibleBounds(), GL_TRIANGLES);
+
+
+    // PLAYER e CUORI
+
+    if (SpaceCleaner* player = getPlayer()) {
+        // Accoda la navicella del giocatore
+        float worldLeft = -(camera->getWidth() / camera->getHeight());
+        renderer->submitEntity(*player, RenderLayer::Player, GL_TRIANGLES);
+
+		// Disegna i cuori della salute in alto a sinistra
+        glm::vec2 startPos = glm::vec2(worldLeft + 0.05f, 1.0f - 0.05f);  // Angolo in alto a sinistra
+        float spacing = 0.08f;      // Distanza tra cuori
+        float heartScale = 0.1f;    // Dimensione cuori
+
+        int currentHealth = player->getHealth();
+        int maxHealth = player->getMaxHealth();
+
+        // Disegna i cuori (pieni = salute, vuoti = salute persa)
+        for (int i = 0; i < maxHealth; ++i) {
+            // Colore: rosso pieno se attivo, grigio trasparente se vuoto
+            glm::vec4 color = (i < currentHealth) ?
+                glm::vec4(1.0f, 0.0f, 0.4f, 1.0f) :      // Rosa acceso
+                glm::vec4(0.3f, 0.3f, 0.3f, 0.5f);       // Grigio trasparente
+
+            // Posiziona e scala il cuore
+            Affine2D model = Affine2D::translation(glm::vec2(startPos.x + i * spacing, startPos.y))
+                * Affine2D::scaling(heartScale);
+
+            // Accoda il cuore nel layer dell'HUD
+            renderer->submitMesh(
+                this->heartMeshId,
+                this->defaultShaderId,
+                color,
+                model,
+                RenderLayer::Hud,
+                GL_TRIANGLES
+            );
+        }
+    }
+
+    // DEBUG: BOUNDING BOX
+
+    // Mostra i bounding box per debug collisioni
+    if (imguiManager->boundingBoxMode) {
+        if (scene) {
+            for (const auto& entity : scene->getEntities()) {
+                renderer->submitBoundingBox(entity->getAABB(), glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+            }
+        }
+    }
+
+    // Ordina ed esegue i pacchetti accodati: prima gli opachi, poi lo sfondo, infine i trasparenti
+    renderer->flushOpaque();
+    if (backgroundLast)
+        drawBackground(renderSize.x, renderSize.y);
+    renderer->flushTranslucent();
+
+    // Riporta la scena alla dimensione della finestra; ImGui disegna poi a piena risoluzione
+    dynamicResolution->end(screenWidth, screenHeight);
+
+    // INTERFACCIA IMGUI
+
+    // Mostra ImGui se visibile o se non in gioco
+    if (imguiVisible || currentState != GameState::PLAYING) {
+        imguiManager->beginFrame();
+
+        // Editor/Debug UI
+        if (imguiVisible) {
+            imguiManager->drawEditorWindow(this);
+        }
+
+        // Menu contestuali basati sullo stato
+        if (currentState == GameState::START) {
+            imguiManager->drawStartMenu(this);
+        }
+        else if (currentState == GameState::PAUSED) {
+            imguiManager->drawPauseMenu(this);
+        }
+        else if (currentState == GameState::GAME_OVER) {
+            imguiManager->drawGameOverMenu(this);
+        }
+
+        imguiManager->endFrame();
+    }
+
+    // Aggiorna il buffer della finestra (swap buffers)
+    window->updateWindow();
+}
+
+/**
+ * Resetta il gioco allo stato iniziale
+ * - Ripristina salute del player
+ * - Azzera punteggio
+ * - Torna allo stato PLAYING
+ */
+void Engine::resetGame() {
+    currentState = PLAYING;
+    if (SpaceCleaner* player = getPlayer())
+        player->resetHealth();
+    scoreManager.reset();
+}
+
+/**
+ * Loop principale del gioco
+ * La funzione è un'implementazione del game loop pattern con simulazione a passo fisso.
+ * 
+ * Pattern:
+ * 1. Aggiorna timer, calcola deltaTime e accumula il tempo da simulare
+ * 2. Processa eventi finestra
+ * 3. Gestisci input
+ * 4. Aggiorna lo stato legato al frame
+ * 5. Esegue zero o più passi fissi di simulazione (al massimo Timer::maxCatchUpSteps)
+ * 6. Renderizza interpolando tra gli ultimi due passi
+ *
+ * Il frame rate del rendering è indipendente dalla simulazione (V-Sync o limite FPS).
+ */
+void Engine::gameLoop() {
+    Timer::init(); // Inizializza il sistema di timing
+
+    while (window->windowIsOpen()) {
+        Timer::update();                  // Tempo reale del frame
+        float delta = Timer::getDeltaTime();
+
+        window->pollEvents();             // Eventi GLFW (resize, close, etc.)
+        processInput();                   // Input utente
+        update(delta);                    // Stato legato al frame
+
+        while (Timer::stepSimulation())   // Logica di gioco a passo fisso
+            fixedUpdate(Timer::getFixedDeltaTime());
+
+        rendering();                      // Rendering
+    }
+}
+
+// INIZIALIZZAZIONE
+
+/**
+ * Inizializza l'intero engine
+ *
+ * Setup:
+ * 0. JobSystem e tassellazione delle navicelle in background (non richiede OpenGL)
+ * 1. Contesto OpenGL/GLFW
+ * 2. Finestra e camera
+ * 3. Renderer e input
+ * 4. ImGui
+ * 5. Caricamento risorse (shader, mesh, configurazioni)
+ * 6. Creazione player e scene
+ */
+void Engine::init() {
+    JobSystem::init(); // Un worker per core, usati dal caricamento e dall'update della scena
+
+    // La fase CPU della nave iniziale procede mentre si crea la finestra
+    // e il driver compila gli shader; loadAllResources ne raccoglie il risultato
+    const unsigned int initialPlayerConfig = 0;
+    resourceLoader = std::make_unique<ResourceLoader>();
+    resourceLoader->beginPlayerMeshes(initialPlayerConfig);
+
+	// Configurazione GLFW per OpenGL 3.3 Core Profile
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
+
+	// Creazione finestra di gioco
+    int width = 1000;
+    int height = 800;
+    window = std::make_unique<Window>(width, height);
+    window->setVSync(true); // Il rendering segue il refresh del monitor, la simulazione resta a passo fisso
+
+    camera = std::make_unique<Camera>(width, height);
+    renderer = std::make_unique<Renderer>();
+    backgroundPass = std::make_unique<BackgroundPass>();
+    dynamicResolution = std::make_unique<DynamicResolution>();
+
+    // Callback per aggiornare la proiezione quando la finestra cambia dimensione
+    window->setResizeCallback([this](int newWidth, int newHeight) {
+        if (camera) {
+            camera->setProjection(newWidth, newHeight);
+        }
+        });
+
+	// Inizializza InputManager e l'API di ImGUI con il riferimento alla finestra GLFW
+    InputManager::init(window->getWindowReference());
+    imguiManager = std::make_unique<ImGuiManager>(window->getWindowReference());
+    scene = std::make_unique<Scene>();
+
+    // Abilita blending per trasparenza
+    GLStateCache::setBlend(true);
+    GLStateCache::setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    
+    // CARICAMENTO RISORSE
+
+    // Il warm-up degli shader durante il caricamento legge il blocco FrameData: va creato prima
+    renderer->updateFrameData(glm::vec2(width, height), 0.0f);
+
+    // Usa ResourceLoader per caricare shader, mesh e configurazioni
+    resourceLoader->loadAllResources(
+        this->defaultShaderId,
+        this->instancedShaderId,
+        this->projectileMeshId,
+        this->heartMeshId,
+        this->backgroundMeshId,
+        this->playerConfigs,
+        this->backgroundConfigs,
+        initialPlayerConfig
+    );
+    renderer->setInstancedShader(this->defaultShaderId, this->instancedShaderId);
+
+	/**
+    * CREAZIONE PLAYER E MESH PERSONALIZZATE
+    * In questa sezione ho voluto far vedere un dettaglio implementativo.
+    * Inizialmente le entità venivano create con mesh interne al codice.
+	* Ho intenzionalmente mantenuto questa parte per mostrare il processo di creazione
+    * e di evoluzione in termini di design della creazione di una mesh.
+    */
+    auto player = std::make_shared<SpaceCleaner>("SpaceCleaner", this);
+    player->setSpeed(playerSpeed);
+    player->setTurnSpeed(playerTurnSpeed);
+
+    // --- ASTEROIDE ---
+    // Forma irregolare con 7 punti di controllo
+    std::vector<glm::vec2> asteroidPoints = {
+        glm::vec2(0.2f, 0.4f),
+        glm::vec2(0.6f, 0.2f),
+        glm::vec2(0.3f, -0.1f),
+        glm::vec2(0.5f, -0.4f),
+        glm::vec2(-0.2f, -0.5f),
+        glm::vec2(-0.6f, -0.1f),
+        glm::vec2(-0.4f, 0.3f)
+    };
+    asteroidMeshId = HermiteMesh::baseHermiteToMesh("AsteroidShape", asteroidPoints, 40);
+
+    // --- COMETA ---
+    // Forma allungata con 6 punti di controllo
+    std::vector<glm::vec2> cometPoints = {
+        glm::vec2(0.0f, 0.6f),
+        glm::vec2(0.1f, 0.3f),
+        glm::vec2(0.15f, 0.0f),
+        glm::vec2(0.0f, -0.1f),
+        glm::vec2(-0.15f, 0.0f),
+        glm::vec2(-0.1f, 0.3f)
+    };
+    cometMeshId = HermiteMesh::baseHermiteToMesh("CometShape", cometPoints, 30);
+
+
+    // Imposta lo shader di background iniziale
+    if (!backgroundConfigs.empty()) {
+        this->backgroundShaderId = backgroundConfigs[0].shaderId;
+        imguiManager->currentBackgroundSelection = 0;
+    }
+
+    // Aggiungi il player alla scena: da qui in poi l'Engine lo raggiunge tramite handle
+    playerHandle = scene->addEntity(player);
+
+    // Applica la configurazione iniziale del player (Modello 1, indice 0)
+    applyPlayerConfig(initialPlayerConfig);
 }
\ No newline at end of file
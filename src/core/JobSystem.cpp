@@ -0,0 +1,222 @@
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Lavoro asincrono: la funzione resta viva finché l'handle non viene rilasciato
+struct JobSystem::Batch {
+    RangeFunction function;
+    std::atomic<size_t> pending{ 0 };
+};
+
+namespace {
+    /// Un blocco di lavoro: intervallo e funzione da eseguire
+    struct Job {
+        const JobSystem::RangeFunction* function = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+        std::atomic<size_t>* pending = nullptr; ///< Blocchi ancora da completare del gruppo
+    };
+
+    /// Coda di un worker: il proprietario lavora in coda, i ladri in testa
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    struct JobSystemState {
+        std::vector<std::thread> threads;
+        std::vector<std::unique_ptr<WorkerQueue>> queues; ///< Una coda per worker (0 = thread principale)
+        std::atomic<bool> running{ false };
+        std::atomic<size_t> queuedJobs{ 0 };              ///< Job in coda non ancora prelevati
+        std::mutex sleepMutex;
+        std::condition_variable wakeUp;
+    };
+
+    JobSystemState state;
+    thread_local unsigned currentWorker = 0;
+
+    bool popLocal(unsigned worker, Job& job) {
+        WorkerQueue& queue = *state.queues[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) return false;
+        job = queue.jobs.back();
+        queue.jobs.pop_back();
+        return true;
+    }
+
+    bool steal(unsigned thief, Job& job) {
+        const unsigned count = static_cast<unsigned>(state.queues.size());
+        for (unsigned i = 1; i < count; ++i) {
+            WorkerQueue& queue = *state.queues[(thief + i) % count];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.jobs.empty()) {
+                job = queue.jobs.front();
+                queue.jobs.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Preleva ed esegue un job (prima dalla coda propria, poi rubando). false se non c'era lavoro.
+    bool runOneJob(unsigned worker) {
+        Job job;
+        if (!popLocal(worker, job) && !steal(worker, job)) {
+            return false;
+        }
+        state.queuedJobs--;
+
+        (*job.function)(job.begin, job.end, worker);
+        (*job.pending)--;
+        return true;
+    }
+
+    /// Accoda i blocchi di [0, count) sul worker indicato e sveglia i thread addormentati
+    void enqueueBlocks(unsigned worker, size_t count, size_t grainSize, size_t blockCount,
+        const JobSystem::RangeFunction* function, std::atomic<size_t>* pending) {
+        // Il contatore sale prima dell'accodamento, così non può scendere sotto zero
+        {
+            std::lock_guard<std::mutex> lock(state.sleepMutex);
+            state.queuedJobs += blockCount;
+        }
+        {
+            WorkerQueue& queue = *state.queues[worker];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            for (size_t b = blockCount; b > 0; --b) {
+                Job job;
+                job.function = function;
+                job.begin = (b - 1) * grainSize;
+                job.end = std::min(count, job.begin + grainSize);
+                job.pending = pending;
+                queue.jobs.push_back(job);
+            }
+        }
+        state.wakeUp.notify_all();
+    }
+
+    void workerLoop(unsigned worker) {
+        currentWorker = worker;
+        while (state.running) {
+            if (runOneJob(worker)) continue;
+
+            // Nessun lavoro: dorme finché non arrivano job o lo spegnimento
+            std::unique_lock<std::mutex> lock(state.sleepMutex);
+            state.wakeUp.wait(lock, [] { return state.queuedJobs > 0 || !state.running; });
+        }
+    }
+}
+
+void JobSystem::init(unsigned workerCount) {
+    shutdown();
+
+    if (workerCount == 0) {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    state.queues.clear();
+    for (unsigned i = 0; i < workerCount; ++i) {
+        state.queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    state.running = true;
+    for (unsigned i = 1; i < workerCount; ++i) {
+        state.threads.emplace_back(workerLoop, i);
+    }
+}
+
+void JobSystem::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(state.sleepMutex);
+        state.running = false;
+    }
+    state.wakeUp.notify_all();
+
+    for (auto& thread : state.threads) {
+        thread.join();
+    }
+    state.threads.clear();
+    state.queues.clear();
+    state.queuedJobs = 0;
+}
+
+unsigned JobSystem::getWorkerCount() {
+    return state.queues.empty() ? 1u : static_cast<unsigned>(state.queues.size());
+}
+
+unsigned JobSystem::getCurrentWorkerIndex() {
+    return currentWorker;
+}
+
+/**
+ * @brief Divide l'intervallo in blocchi, li accoda sul worker corrente e aiuta fino al termine.
+ *
+ * I blocchi vengono accodati in ordine inverso: il proprietario li preleva dalla coda
+ * partendo dal primo, mentre i ladri prendono quelli in fondo all'intervallo.
+ */
+void JobSystem::parallelFor(size_t count, size_t grainSize, const RangeFunction& function) {
+    if (count == 0) return;
+
+    grainSize = std::max<size_t>(1, grainSize);
+    const size_t blockCount = (count + grainSize - 1) / grainSize;
+    const unsigned worker = currentWorker;
+
+    if (blockCount == 1 || state.threads.empty()) {
+        function(0, count, worker);
+        return;
+    }
+
+    std::atomic<size_t> pending{ blockCount };
+    enqueueBlocks(worker, count, grainSize, blockCount, &function, &pending);
+
+    // Il chiamante partecipa finché tutti i blocchi non sono completati
+    while (pending > 0) {
+        if (!runOneJob(worker)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/**
+ * @brief Accoda i blocchi sul worker corrente senza attenderli.
+ *
+ * A differenza di parallelFor anche un solo blocco va ai worker: lo scopo è liberare
+ * il chiamante, non suddividere il lavoro.
+ */
+JobSystem::BatchHandle JobSystem::dispatch(size_t count, size_t grainSize, RangeFunction function) {
+    auto batch = std::make_shared<Batch>();
+    batch->function = std::move(function);
+    if (count == 0) return batch;
+
+    grainSize = std::max<size_t>(1, grainSize);
+    const size_t blockCount = (count + grainSize - 1) / grainSize;
+
+    if (state.threads.empty()) {
+        batch->function(0, count, currentWorker);
+        return batch;
+    }
+
+    batch->pending = blockCount;
+    enqueueBlocks(currentWorker, count, grainSize, blockCount, &batch->function, &batch->pending);
+    return batch;
+}
+
+bool JobSystem::isDone(const BatchHandle& batch) {
+    return !batch || batch->pending == 0;
+}
+
+void JobSystem::wait(const BatchHandle& batch) {
+    if (!batch) return;
+
+    const unsigned worker = currentWorker;
+    while (batch->pending > 0) {
+        if (!runOneJob(worker)) {
+            std::this_thread::yield();
+        }
+    }
+}
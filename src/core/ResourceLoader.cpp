@@ -1,249 +1,478 @@
-#include "core/ResourceLoader.h"
-#include <iostream>
-#include <glm/gtc/matrix_transform.hpp>
-
-/**
- * Punto di ingresso per il caricamento delle risorse.
- * Segue un ordine preciso per rispettare le dipendenze.
- */
-void ResourceLoader::loadAllResources(
-    unsigned int& defaultShaderId,
-    unsigned int& projectileMeshId,
-    unsigned int& heartMeshId,
-    unsigned int& backgroundMeshId,
-    std::vector<PlayerConfig>& playerConfigs,
-    std::vector<BackgroundConfig>& backgroundConfigs
-) {
-    // 1. Carica lo shader di default (NECESSARIO per step 3)
-    defaultShaderId = loadDefaultShader();
-
-    // 2. Carica mesh di gioco (indipendenti)
-    loadGameMeshes(projectileMeshId, heartMeshId, backgroundMeshId);
-
-    // 3. Carica configurazioni player (DIPENDE da defaultShaderId)
-    loadPlayerConfigs(playerConfigs, defaultShaderId);
-
-    // 4. Carica configurazioni background (DIPENDE da backgroundMeshId)
-    loadBackgrounds(backgroundConfigs, backgroundMeshId);
-}
-
-/**
- * Carica e compila lo shader di default utilizzato per la maggior parte
- * degli oggetti del gioco (player, nemici, proiettili, UI).
- */
-unsigned int ResourceLoader::loadDefaultShader() {
-    // Legge i sorgenti shader da file
-    std::string vertexCode = readShaderFile("resources/vertex.glsl");
-    std::string fragmentCode = readShaderFile("resources/fragment.glsl");
-
-    // Compila e registra lo shader nel ShaderManager
-    return ShaderManager::load("DefaultShader", vertexCode, fragmentCode);
-}
-
-/**
- * Carica tutte le navicelle giocabili del gioco.
- *
- * ARCHITETTURA A LAYER:
- * Ogni navicella  composta da 3 layer sovrapposti:
- * 1. Base: Struttura principale (grigia/neutra)
- * 2. Livery: Decorazione/colore distintivo
- * 3. Cockpit: Cabina di pilotaggio (vetro trasparente)
- *
- * MODELLI DISPONIBILI:
- * - SW: Navicella ispirata a Star Wars (gialla)
- * - X-Wing: Fighter classico (rosso/blu)
- * - BaseShip: Nave standard (arancione)
- */
-void ResourceLoader::loadPlayerConfigs(std::vector<PlayerConfig>& playerConfigs, unsigned int defaultShaderId) {
-    // --- MODELLO SW ---
-    // Carica le 3 componenti della navicella SW dai file di controllo points
-    unsigned int swBaseId = HermiteMesh::catmullRomToMesh("SW_PlayerBase", "resources/BaseSWship.txt", 40);
-    unsigned int swLiveryId = HermiteMesh::catmullRomToMesh("SW_PlayerLivery", "resources/LiverySWship.txt", 40);
-    unsigned int swCockpitId = HermiteMesh::catmullRomToMesh("SW_PlayerCockpit", "resources/CockpitSWship.txt", 40);
-
-    // --- MODELLO BASESHIP ---
-    unsigned int baseShipBaseId = HermiteMesh::catmullRomToMesh("BaseShip_PlayerBase", "resources/BaseFirstShip.txt", 40);
-    unsigned int baseShipLiveryId = HermiteMesh::catmullRomToMesh("BaseShip_PlayerLivery", "resources/LiveryBaseShip.txt", 40);
-    unsigned int baseShipCockpitId = HermiteMesh::catmullRomToMesh("BaseShip_PlayerCockpit", "resources/CockpitFirstShip.txt", 40);
-
-    // --- MODELLO X-WING ---
-    // X-Wing ha pi dettagli (100 e 90 segmenti per base e livery)
-    unsigned int xwingShipBaseId = HermiteMesh::catmullRomToMesh("XWing_PlayerBase", "resources/BaseXwingShip.txt", 100);
-    unsigned int xwingShipLiveryId = HermiteMesh::catmullRomToMesh("XWing_PlayerLivery", "resources/LiveryXwingShip.txt", 90);
-    unsigned int xwingShipCockpitId = HermiteMesh::catmullRomToMesh("XWing_PlayerCockpit", "resources/CockpitXwingShip.txt", 40);
-
-    // CONFIGURAZIONI
-
-    // --- CONFIGURAZIONE SW ---
-    PlayerConfig model1 = {
-        "SW",                           // Nome del modello
-        swBaseId, swLiveryId, swCockpitId,  // ID delle mesh
-
-        // Layer Base: grigio neutro, scala 0.3
-        { "PlayerBase",
-          glm::vec4(0.5f),              // Colore grigio medio
-          glm::scale(glm::mat4(1.0f), glm::vec3(0.3f)) },
-
-          // Layer Livery: giallo brillante, leggermente pi grande e traslato
-          { "PlayerLivery",
-            glm::vec4(0.9f, 0.9f, 0.0f, 1.0f),  // Colore giallo
-            glm::translate(
-                glm::scale(glm::mat4(1.0f), glm::vec3(0.31f)),
-                glm::vec3(-0.01f, 0.02f, 0.1f)    // Offset Z per sovrapposizione
-            ) },
-
-        // Layer Cockpit: quasi nero, trasparente al 70%
-        { "PlayerCockpit",
-          glm::vec4(0.1f, 0.1f, 0.1f, 0.7f),  // Grigio scuro trasparente
-          glm::translate(
-              glm::scale(glm::mat4(1.0f), glm::vec3(0.3f)),
-              glm::vec3(-0.04f, 0.1f, 0.2f)     // Z pi alto per visibilit
-          ) }
-    };
-
-    // --- CONFIGURAZIONE X-WING ---
-    PlayerConfig model2 = {
-        "X-Wing",
-        xwingShipBaseId, xwingShipLiveryId, xwingShipCockpitId,
-
-        // Base: grigio scuro, scala 0.4 (pi grande)
-        { "PlayerBase",
-          glm::vec4(0.3f, 0.3f, 0.3f, 1.0f),
-          glm::scale(glm::mat4(1.0f), glm::vec3(0.4f)) },
-
-          // Livery: rosso scuro (tema X-Wing Rebel Alliance)
-          { "PlayerLivery",
-            glm::vec4(0.5f, 0.0f, 0.0f, 1.0f),
-            glm::translate(
-                glm::scale(glm::mat4(1.0f), glm::vec3(0.5f)),
-                glm::vec3(0.03f, -0.03f, 0.1f)
-            ) },
-
-        // Cockpit: blu traslucido (vetro colorato)
-        { "PlayerCockpit",
-          glm::vec4(0.2f, 0.2f, 0.8f, 0.7f),
-          glm::translate(
-              glm::scale(glm::mat4(1.0f), glm::vec3(0.6f)),
-              glm::vec3(0.02f, -0.2f, 0.2f)
-          ) }
-    };
-
-    // --- CONFIGURAZIONE BASESHIP ---
-    PlayerConfig model3 = {
-        "BaseShip",
-        baseShipBaseId, baseShipLiveryId, baseShipCockpitId,
-
-        // Base: rosso scuro
-        { "PlayerBase",
-          glm::vec4(0.7f, 0.7f, 0.7f, 1.0f),
-          glm::scale(glm::mat4(1.0f), glm::vec3(0.35f)) },
-
-          // Livery: grigio medio
-          { "PlayerLivery",
-            glm::vec4(0.5f, 0.5f, 0.5f, 1.0f),
-            glm::translate(
-                glm::scale(glm::mat4(1.0f), glm::vec3(0.35f)),
-                glm::vec3(-0.05f, -0.1f, 0.05f)
-            ) },
-
-        // Cockpit: arancione trasparente
-        { "PlayerCockpit",
-          glm::vec4(1.0f, 0.8f, 0.0f, 0.7f),
-          glm::translate(
-              glm::scale(glm::mat4(1.0f), glm::vec3(0.35f)),
-              glm::vec3(-0.06f, -0.05f, 0.1f)
-          ) }
-    };
-
-    // Popola il vettore di configurazioni (ordine menu)
-    playerConfigs = { model1, model2, model3 };
-}
-
-
-/**
- * Genera proceduralmente le mesh utilizzate durante il gameplay e l'UI.
- *
- * Utilizza curve di Hermite per creare forme partendo dai punti di controllo.
- */
-void ResourceLoader::loadGameMeshes(unsigned int& projectileMeshId, unsigned int& heartMeshId, unsigned int& backgroundMeshId) {
-    // MESH PROIETTILE
-    // Forma a rombo (diamante) per proiettili veloci e visibili
-    std::vector<glm::vec2> projectilePoints = {
-        {0.0f, 0.05f},      // Punta superiore
-        {0.015f, 0.0f},     // Punta destra
-        {0.0f, -0.05f},     // Punta inferiore
-        {-0.015f, 0.0f}     // Punta sinistra
-    };
-    projectileMeshId = HermiteMesh::baseHermiteToMesh("ProjectileShape", projectilePoints, 10);
-
-    // MESH CUORE (UI SALUTE)
-    // Forma classica a cuore per indicatore salute
-    // 9 punti di controllo per creare le curve caratteristiche
-    std::vector<glm::vec2> heartPoints = {
-        {0.003f, 0.16f},      // Centro superiore
-        {0.124f, 0.301f},     // Lobo destro superiore
-        {0.177f, 0.178f},     // Lobo destro laterale
-        {0.186f, 0.012f},     // Curva destra
-        {0.0013f, -0.42f},    // Punta inferiore
-        {-0.186f, 0.012f},    // Curva sinistra
-        {-0.177f, 0.178f},    // Lobo sinistro laterale
-        {-0.124f, 0.301f},    // Lobo sinistro superiore
-        {0.003f, 0.16f}       // Chiusura (ritorna al primo punto)
-    };
-    // 30 segmenti per curve smooth
-    heartMeshId = HermiteMesh::baseHermiteToMesh("HeartShape", heartPoints, 30);
-
-    // MESH BACKGROUND (QUAD FULLSCREEN)
-    // Semplice quad che copre l'intera viewport per shader di background
-    std::vector<glm::vec2> quadPoints = {
-        {-1.0f, 1.0f},      // Top-left
-        {1.0f, 1.0f},       // Top-right
-        {1.0f, -1.0f},      // Bottom-right
-        {-1.0f, -1.0f}      // Bottom-left
-    };
-    // 4 vertici = 2 triangoli = 1 quad
-    backgroundMeshId = HermiteMesh::baseHermiteToMesh("BackgroundQuad", quadPoints, 4);
-}
-
-/**
- * Pre-compila tutti gli shader di background disponibili.
- *
- * Ogni background utilizza:
- * - Lo stesso vertex shader (background_vertex.glsl)
- * - Un fragment shader unico che crea l'effetto visivo
- * - La stessa mesh quad fullscreen
- */
-void ResourceLoader::loadBackgrounds(std::vector<BackgroundConfig>& backgroundConfigs, unsigned int& backgroundMeshId) {
-    // Legge il vertex shader comune a tutti i background
-    std::string bgVertexCode = readShaderFile("resources/background_vertex.glsl");
-
-	// CONFIGURAZIONI BACKGROUND DISPONIBILI
-    backgroundConfigs = {
-        // Background 1: Campo stellato semplice
-        {"Default", "resources/defaultbg_fragment_shader.glsl", 0},
-
-        // Background 2: Saturno
-        {"Saturn", "resources/fragmentSaturn.glsl", 0},
-
-        // Background 3: Sole
-        {"Sun theme", "resources/fragmentSun.glsl", 0}
-    };
-
-    // PRE-COMPILAZIONE SHADER E CARICAMENTO NELLO SHADER MANAGER
-    // Pre-carica e compila tutti gli shader per evitare lag durante il cambio
-    for (auto& config : backgroundConfigs) {
-        // Legge il fragment shader specifico
-        std::string frag = readShaderFile(config.fragmentShaderPath);
-
-        // Compila e registra lo shader, salvando l'ID nella config
-        config.shaderId = ShaderManager::load(config.name, bgVertexCode, frag);
-    }
-}
-
-/**
- * Wrapper per la lettura di file shader.
- * Delega alla funzione readFile() delle utilities del progetto.
- */
-std::string ResourceLoader::readShaderFile(const std::string& path) {
-    return readFile(path);
+#include "core/ResourceLoader.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "graphics/ProgramCache.h"
+#include "graphics/Shader.h"
+#include "graphics/Mesh.h"
+#include "graphics/GLStateCache.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+    /// Legge un interruttore da variabile d'ambiente: "0" lo spegne, assente vale il default
+    bool envFlag(const char* name, bool defaultValue) {
+        const char* value = std::getenv(name);
+        if (!value) return defaultValue;
+        return std::strcmp(value, "0") != 0;
+    }
+
+    /// Layer di navicella da tassellare: file dei punti di controllo e dettaglio della curva
+    struct ShipLayerSource {
+        const char* name;
+        const char* path;
+        int segments;
+    };
+
+    const size_t shipModelCount = 3;
+    const size_t layersPerShip = 3;
+
+    /// Layer di ogni modello (base, livery, cockpit), nell'ordine di playerConfigs
+    const ShipLayerSource shipLayerSources[shipModelCount][layersPerShip] = {
+        // --- MODELLO SW ---
+        { { "SW_PlayerBase", "resources/BaseSWship.txt", 40 },
+          { "SW_PlayerLivery", "resources/LiverySWship.txt", 40 },
+          { "SW_PlayerCockpit", "resources/CockpitSWship.txt", 40 } },
+
+        // --- MODELLO X-WING ---
+        // X-Wing ha più dettagli (100 e 90 segmenti per base e livery)
+        { { "XWing_PlayerBase", "resources/BaseXwingShip.txt", 100 },
+          { "XWing_PlayerLivery", "resources/LiveryXwingShip.txt", 90 },
+          { "XWing_PlayerCockpit", "resources/CockpitXwingShip.txt", 40 } },
+
+        // --- MODELLO BASESHIP ---
+        { { "BaseShip_PlayerBase", "resources/BaseFirstShip.txt", 40 },
+          { "BaseShip_PlayerLivery", "resources/LiveryBaseShip.txt", 40 },
+          { "BaseShip_PlayerCockpit", "resources/CockpitFirstShip.txt", 40 } }
+    };
+}
+
+/// Il vettore dei modelli non viene più ridimensionato: i job scrivono nei suoi elementi
+ResourceLoader::ResourceLoader() : shipModels(shipModelCount) {
+}
+
+ResourceLoader::~ResourceLoader() {
+    for (auto& model : shipModels) {
+        JobSystem::wait(model.jobs);
+    }
+}
+
+/**
+ * Un job per layer: i file sono piccoli ma la triangolazione dei layer più dettagliati
+ * domina, quindi blocchi da un elemento bilanciano meglio il carico tra i worker.
+ * Ogni job scrive solo nel proprio elemento dei vettori, dimensionati qui prima dell'invio.
+ */
+void ResourceLoader::beginPlayerMeshes(unsigned int modelIndex) {
+    if (modelIndex >= shipModelCount) return;
+
+    ShipModelMeshes& model = shipModels[modelIndex];
+    if (model.jobs || model.uploaded) return;
+
+    model.layers.assign(layersPerShip, CurveMeshData());
+    model.valid.assign(layersPerShip, 0);
+    model.layerMs.assign(layersPerShip, 0.0);
+
+    ShipModelMeshes* target = &model;
+    model.jobs = JobSystem::dispatch(layersPerShip, 1, [target, modelIndex](size_t begin, size_t end, unsigned) {
+        for (size_t i = begin; i < end; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            const ShipLayerSource& source = shipLayerSources[modelIndex][i];
+            target->valid[i] = HermiteMesh::tessellateCatmullRom(source.path, source.segments, target->layers[i]) ? 1 : 0;
+            target->layerMs[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    });
+}
+
+/**
+ * Avvia la tassellazione se manca e, quando è conclusa, carica i layer su GPU dal thread
+ * principale. La geometria CPU viene poi liberata: da qui il modello vive solo nei buffer.
+ */
+bool ResourceLoader::preparePlayerMeshes(PlayerConfig& config, unsigned int modelIndex, bool wait) {
+    if (modelIndex >= shipModelCount) return false;
+
+    ShipModelMeshes& model = shipModels[modelIndex];
+    if (model.uploaded) return true;
+
+    using Clock = std::chrono::steady_clock;
+    auto elapsedMs = [](Clock::time_point from) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - from).count();
+    };
+
+    beginPlayerMeshes(modelIndex);
+    Clock::time_point stepStart = Clock::now();
+    if (!JobSystem::isDone(model.jobs)) {
+        if (!wait) return false;
+        JobSystem::wait(model.jobs);
+    }
+    const double waitMs = elapsedMs(stepStart);
+
+    // Fase GPU: solo il caricamento nei buffer, sul thread del contesto
+    stepStart = Clock::now();
+    unsigned int layerIds[layersPerShip] = {};
+    double cpuMs = 0.0;
+    for (size_t i = 0; i < layersPerShip; ++i) {
+        cpuMs += model.layerMs[i];
+        if (model.valid[i]) {
+            layerIds[i] = HermiteMesh::uploadCatmullRom(shipLayerSources[modelIndex][i].name, model.layers[i]);
+        }
+    }
+    const double uploadMs = elapsedMs(stepStart);
+
+    config.baseMeshId = layerIds[0];
+    config.liveryMeshId = layerIds[1];
+    config.cockpitMeshId = layerIds[2];
+
+    model.uploaded = true;
+    model.jobs.reset();
+    std::vector<CurveMeshData>().swap(model.layers);
+
+    std::cout << "Navicella " << config.name << ": tassellazione " << cpuMs << " ms CPU, attesa "
+        << waitMs << " ms, upload " << uploadMs << " ms\n";
+    return true;
+}
+
+/**
+ * Punto di ingresso per il caricamento delle risorse.
+ * Segue un ordine preciso per rispettare le dipendenze.
+ *
+ * Gli shader vengono solo accodati all'inizio: mentre il driver li compila (in parallelo
+ * se supporta KHR_parallel_shader_compile) il thread principale genera le mesh. L'esito
+ * viene letto alla fine, seguito da un disegno di warm-up per programma.
+ * SPACECLEANER_SHADER_CACHE=0 e SPACECLEANER_ASYNC_SHADERS=0 disattivano cache e
+ * compilazione differita, SPACECLEANER_LAZY_SHIPS=0 carica subito tutte le navicelle,
+ * per confrontare i tempi di avvio.
+ */
+void ResourceLoader::loadAllResources(
+    unsigned int& defaultShaderId,
+    unsigned int& instancedShaderId,
+    unsigned int& projectileMeshId,
+    unsigned int& heartMeshId,
+    unsigned int& backgroundMeshId,
+    std::vector<PlayerConfig>& playerConfigs,
+    std::vector<BackgroundConfig>& backgroundConfigs,
+    unsigned int selectedPlayerConfig
+) {
+    using Clock = std::chrono::steady_clock;
+    auto elapsedMs = [](Clock::time_point from) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - from).count();
+    };
+    const Clock::time_point loadStart = Clock::now();
+
+    // 0. Cache dei programmi linkati e compilazione differita
+    ProgramCache::setEnabled(envFlag("SPACECLEANER_SHADER_CACHE", true));
+    ProgramCache::init("shader_cache");
+    const bool asyncShaders = envFlag("SPACECLEANER_ASYNC_SHADERS", true);
+    const bool parallel = asyncShaders && Shader::enableParallelCompile();
+    if (asyncShaders) ShaderManager::beginDeferredBuilds();
+
+    // 1. Accoda tutti gli shader: default (NECESSARIO per step 3) e background
+    Clock::time_point stepStart = Clock::now();
+    defaultShaderId = loadDefaultShader();
+    instancedShaderId = loadInstancedShader();
+    loadDebugLineShader();
+    loadBackgrounds(backgroundConfigs, backgroundMeshId);
+    const double submitMs = elapsedMs(stepStart);
+
+    // 2. Carica mesh di gioco (indipendenti), mentre il driver compila
+    stepStart = Clock::now();
+    loadGameMeshes(projectileMeshId, heartMeshId, backgroundMeshId);
+
+    // 3. Carica configurazioni player (servono solo gli ID degli shader):
+    //    la tassellazione gira già sui worker, qui resta il caricamento su GPU della nave scelta
+    loadPlayerConfigs(playerConfigs, defaultShaderId, selectedPlayerConfig, envFlag("SPACECLEANER_LAZY_SHIPS", true));
+    const double overlapMs = elapsedMs(stepStart);
+
+    // 4. Legge l'esito di compilazione e link: da qui gli shader sono utilizzabili
+    stepStart = Clock::now();
+    ShaderManager::finishDeferredBuilds();
+    const double waitMs = elapsedMs(stepStart);
+
+    // 5. Warm-up: il primo disegno di ogni programma avviene ora, non durante la partita
+    stepStart = Clock::now();
+    warmUpShaders(backgroundMeshId);
+    const double warmUpMs = elapsedMs(stepStart);
+
+    const ProgramCacheStats& cache = ProgramCache::getStats();
+    std::cout << "Shader: invio " << submitMs << " ms, attesa " << waitMs << " ms, warm-up " << warmUpMs
+        << " ms (" << (asyncShaders ? (parallel ? "differiti, parallelo" : "differiti") : "sincroni")
+        << "; cache " << (ProgramCache::isActive() ? "attiva" : "disattivata") << ": " << cache.hits << " hit, "
+        << cache.misses << " miss, " << cache.stores << " salvati)\n";
+    if (asyncShaders) {
+        // La compilazione si è sovrapposta alla generazione delle mesh: il tempo risparmiato
+        // rispetto all'avvio sincrono è al più quello della generazione
+        std::cout << "Shader: " << overlapMs << " ms di caricamento mesh eseguiti durante la compilazione\n";
+    }
+    std::cout << "Risorse caricate in " << elapsedMs(loadStart) << " ms\n";
+}
+
+/**
+ * Un disegno per programma, limitato a un pixel e senza scritture, con la mesh indicata.
+ *
+ * Molti driver completano la compilazione (o la specializzano per lo stato corrente) solo
+ * al primo disegno: farlo qui sposta l'intoppo nel caricamento invece che nel primo frame
+ * in cui compare lo shader (es. al cambio di sfondo). Il blocco FrameData deve essere già collegato.
+ */
+void ResourceLoader::warmUpShaders(unsigned int meshId) {
+    auto mesh = MeshManager::getById(meshId);
+    if (!mesh) return;
+
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(0, 0, 1, 1);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    GLStateCache::setDepthWrite(false);
+
+    for (const auto& entry : ShaderManager::getAll()) {
+        const std::shared_ptr<Shader>& shader = entry.second;
+        if (!shader->isValid()) continue;
+        shader->bind();
+        mesh->draw(*shader, GL_TRIANGLES);
+    }
+
+    // Attende la GPU: il costo della compilazione al primo disegno resta nel caricamento
+    glFinish();
+
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glDisable(GL_SCISSOR_TEST);
+    GLStateCache::setDepthWrite(true);
+    GLStateCache::useProgram(0);
+}
+
+/**
+ * Carica e compila lo shader di default utilizzato per la maggior parte
+ * degli oggetti del gioco (player, nemici, proiettili, UI).
+ */
+unsigned int ResourceLoader::loadDefaultShader() {
+    // Legge i sorgenti shader da file
+    std::string vertexCode = readShaderFile("resources/vertex.glsl");
+    std::string fragmentCode = readShaderFile("resources/fragment.glsl");
+
+    // Compila e registra lo shader nel ShaderManager
+    return ShaderManager::load("DefaultShader", vertexCode, fragmentCode);
+}
+
+/**
+ * Carica lo shader usato per disegnare in un'unica chiamata tutte le sub-mesh
+ * che condividono mesh e shader di default (ostacoli, proiettili).
+ */
+unsigned int ResourceLoader::loadInstancedShader() {
+    std::string vertexCode = readShaderFile("resources/vertex_instanced.glsl");
+    std::string fragmentCode = readShaderFile("resources/fragment_instanced.glsl");
+
+    return ShaderManager::load("DefaultInstancedShader", vertexCode, fragmentCode);
+}
+
+/**
+ * Carica lo shader delle linee di debug (bounding box, cerchi): il colore
+ * è un attributo per vertice, come nella variante instanced.
+ */
+unsigned int ResourceLoader::loadDebugLineShader() {
+    std::string vertexCode = readShaderFile("resources/debug_vertex.glsl");
+    std::string fragmentCode = readShaderFile("resources/fragment_instanced.glsl");
+
+    return ShaderManager::load("DebugLineShader", vertexCode, fragmentCode);
+}
+
+/**
+ * Carica tutte le navicelle giocabili del gioco.
+ *
+ * ARCHITETTURA A LAYER:
+ * Ogni navicella è composta da 3 layer sovrapposti:
+ * 1. Base: Struttura principale (grigia/neutra)
+ * 2. Livery: Decorazione/colore distintivo
+ * 3. Cockpit: Cabina di pilotaggio (vetro trasparente)
+ *
+ * MODELLI DISPONIBILI:
+ * - SW: Navicella ispirata a Star Wars (gialla)
+ * - X-Wing: Fighter classico (rosso/blu)
+ * - BaseShip: Nave standard (arancione)
+ */
+void ResourceLoader::loadPlayerConfigs(std::vector<PlayerConfig>& playerConfigs, unsigned int defaultShaderId,
+    unsigned int selectedConfig, bool lazyShips) {
+    // Gli ID delle mesh restano 0 finché preparePlayerMeshes non carica il modello
+    // CONFIGURAZIONI
+
+    // --- CONFIGURAZIONE SW ---
+    PlayerConfig model1 = {
+        "SW",                           // Nome del modello
+        0, 0, 0,                        // ID delle mesh (assegnati al caricamento)
+
+        // Layer Base: grigio neutro, scala 0.3
+        { "PlayerBase",
+          glm::vec4(0.5f),              // Colore grigio medio
+          glm::scale(glm::mat4(1.0f), glm::vec3(0.3f)) },
+
+          // Layer Livery: giallo brillante, leggermente più grande e traslato
+          { "PlayerLivery",
+            glm::vec4(0.9f, 0.9f, 0.0f, 1.0f),  // Colore giallo
+            glm::translate(
+                glm::scale(glm::mat4(1.0f), glm::vec3(0.31f)),
+                glm::vec3(-0.01f, 0.02f, 0.1f)    // Offset Z per sovrapposizione
+            ) },
+
+        // Layer Cockpit: quasi nero, trasparente al 70%
+        { "PlayerCockpit",
+          glm::vec4(0.1f, 0.1f, 0.1f, 0.7f),  // Grigio scuro trasparente
+          glm::translate(
+              glm::scale(glm::mat4(1.0f), glm::vec3(0.3f)),
+              glm::vec3(-0.04f, 0.1f, 0.2f)     // Z più alto per visibilità
+          ) }
+    };
+
+    // --- CONFIGURAZIONE X-WING ---
+    PlayerConfig model2 = {
+        "X-Wing",
+        0, 0, 0,
+
+        // Base: grigio scuro, scala 0.4 (più grande)
+        { "PlayerBase",
+          glm::vec4(0.3f, 0.3f, 0.3f, 1.0f),
+          glm::scale(glm::mat4(1.0f), glm::vec3(0.4f)) },
+
+          // Livery: rosso scuro (tema X-Wing Rebel Alliance)
+          { "PlayerLivery",
+            glm::vec4(0.5f, 0.0f, 0.0f, 1.0f),
+            glm::translate(
+                glm::scale(glm::mat4(1.0f), glm::vec3(0.5f)),
+                glm::vec3(0.03f, -0.03f, 0.1f)
+            ) },
+
+        // Cockpit: blu traslucido (vetro colorato)
+        { "PlayerCockpit",
+          glm::vec4(0.2f, 0.2f, 0.8f, 0.7f),
+          glm::translate(
+              glm::scale(glm::mat4(1.0f), glm::vec3(0.6f)),
+              glm::vec3(0.02f, -0.2f, 0.2f)
+          ) }
+    };
+
+    // --- CONFIGURAZIONE BASESHIP ---
+    PlayerConfig model3 = {
+        "BaseShip",
+        0, 0, 0,
+
+        // Base: rosso scuro
+        { "PlayerBase",
+          glm::vec4(0.7f, 0.7f, 0.7f, 1.0f),
+          glm::scale(glm::mat4(1.0f), glm::vec3(0.35f)) },
+
+          // Livery: grigio medio
+          { "PlayerLivery",
+            glm::vec4(0.5f, 0.5f, 0.5f, 1.0f),
+            glm::translate(
+                glm::scale(glm::mat4(1.0f), glm::vec3(0.35f)),
+                glm::vec3(-0.05f, -0.1f, 0.05f)
+            ) },
+
+        // Cockpit: arancione trasparente
+        { "PlayerCockpit",
+          glm::vec4(1.0f, 0.8f, 0.0f, 0.7f),
+          glm::translate(
+              glm::scale(glm::mat4(1.0f), glm::vec3(0.35f)),
+              glm::vec3(-0.06f, -0.05f, 0.1f)
+          ) }
+    };
+
+    // Popola il vettore di configurazioni (ordine menu)
+    playerConfigs = { model1, model2, model3 };
+
+    // La nave selezionata serve al primo frame: la si attende e la si carica subito.
+    // Le altre vengono tassellate sui worker ma caricate su GPU solo alla prima selezione
+    // (Engine::applyPlayerConfig); senza caricamento pigro si caricano tutte ora.
+    for (unsigned int i = 0; i < playerConfigs.size(); ++i) {
+        if (i == selectedConfig || !lazyShips) {
+            preparePlayerMeshes(playerConfigs[i], i, true);
+        }
+        else {
+            beginPlayerMeshes(i);
+        }
+    }
+}
+
+
+/**
+ * Genera proceduralmente le mesh utilizzate durante il gameplay e l'UI.
+ *
+ * Utilizza curve di Hermite per creare forme partendo dai punti di controllo.
+ */
+void ResourceLoader::loadGameMeshes(unsigned int& projectileMeshId, unsigned int& heartMeshId, unsigned int& backgroundMeshId) {
+    // MESH PROIETTILE
+    // Forma a rombo (diamante) per proiettili veloci e visibili
+    std::vector<glm::vec2> projectilePoints = {
+        {0.0f, 0.05f},      // Punta superiore
+        {0.015f, 0.0f},     // Punta destra
+        {0.0f, -0.05f},     // Punta inferiore
+        {-0.015f, 0.0f}     // Punta sinistra
+    };
+    projectileMeshId = HermiteMesh::baseHermiteToMesh("ProjectileShape", projectilePoints, 10);
+
+    // MESH CUORE (UI SALUTE)
+    // Forma classica a cuore per indicatore salute
+    // 9 punti di controllo per creare le curve caratteristiche
+    std::vector<glm::vec2> heartPoints = {
+        {0.003f, 0.16f},      // Centro superiore
+        {0.124f, 0.301f},     // Lobo destro superiore
+        {0.177f, 0.178f},     // Lobo destro laterale
+        {0.186f, 0.012f},     // Curva destra
+        {0.0013f, -0.42f},    // Punta inferiore
+        {-0.186f, 0.012f},    // Curva sinistra
+        {-0.177f, 0.178f},    // Lobo sinistro laterale
+        {-0.124f, 0.301f},    // Lobo sinistro superiore
+        {0.003f, 0.16f}       // Chiusura (ritorna al primo punto)
+    };
+    // 30 segmenti per curve smooth
+    heartMeshId = HermiteMesh::baseHermiteToMesh("HeartShape", heartPoints, 30);
+
+    // MESH BACKGROUND (QUAD FULLSCREEN)
+    // Semplice quad che copre l'intera viewport per shader di background
+    std::vector<glm::vec2> quadPoints = {
+        {-1.0f, 1.0f},      // Top-left
+        {1.0f, 1.0f},       // Top-right
+        {1.0f, -1.0f},      // Bottom-right
+        {-1.0f, -1.0f}      // Bottom-left
+    };
+    // 4 vertici = 2 triangoli = 1 quad
+    backgroundMeshId = HermiteMesh::baseHermiteToMesh("BackgroundQuad", quadPoints, 4);
+}
+
+/**
+ * Pre-compila tutti gli shader di background disponibili.
+ *
+ * Ogni background utilizza:
+ * - Lo stesso vertex shader (background_vertex.glsl)
+ * - Un fragment shader unico che crea l'effetto visivo
+ * - La stessa mesh quad fullscreen
+ */
+void ResourceLoader::loadBackgrounds(std::vector<BackgroundConfig>& backgroundConfigs, unsigned int& backgroundMeshId) {
+    // Legge il vertex shader comune a tutti i background
+    std::string bgVertexCode = readShaderFile("resources/background_vertex.glsl");
+
+	// CONFIGURAZIONI BACKGROUND DISPONIBILI
+    backgroundConfigs = {
+        // Background 1: Campo stellato semplice
+        {"Default", "resources/defaultbg_fragment_shader.glsl", 0},
+
+        // Background 2: Saturno
+        {"Saturn", "resources/fragmentSaturn.glsl", 0},
+
+        // Background 3: Sole
+        {"Sun theme", "resources/fragmentSun.glsl", 0}
+    };
+
+    // PRE-COMPILAZIONE SHADER E CARICAMENTO NELLO SHADER MANAGER
+    // Pre-carica e compila tutti gli shader per evitare lag durante il cambio
+    for (auto& config : backgroundConfigs) {
+        // Legge il fragment shader specifico
+        std::string frag = readShaderFile(config.fragmentShaderPath);
+
+        // Compila e registra lo shader, salvando l'ID nella config
+        config.shaderId = ShaderManager::load(config.name, bgVertexCode, frag);
+    }
+}
+
+/**
+ * Wrapper per la lettura di file shader.
+ * Delega alla funzione readFile() delle utilities del progetto.
+ */
+std::string ResourceLoader::readShaderFile(const std::string& path) {
+    return readFile(path);
 }
\ No newline at end of file
@@ -1,18 +1,21 @@
-#include "game/Collision.h"
-
-AABB calculateMeshAABB(const std::shared_ptr<Mesh>& mesh, const glm::mat4& transformMatrix) {
-    AABB box;
-    const auto& verts = mesh->getVertices(); // Prendo i vertici dalla mesh
-
-    for (size_t i = 0; i < verts.size(); i += 3) {
-        glm::vec4 vertexPos(verts[i], verts[i + 1], verts[i + 2], 1.0f);
-		vertexPos = transformMatrix * vertexPos; // Applico la matrice di trasformazione, in altre parole il sistema di riferimento globale dell'entit
-
-        glm::vec2 xy(vertexPos.x, vertexPos.y);
-        // Calcolo la Bounding Box
-        box.min = glm::min(box.min, xy);
-        box.max = glm::max(box.max, xy);
-    }
-
-    return box;
-}
+#include "game/Collision.h"
+#include <cmath>
+
+AABB calculateMeshAABB(const Mesh& mesh, const Affine2D& transform) {
+    const glm::vec2& localMin = mesh.getMin();
+    const glm::vec2& localMax = mesh.getMax();
+
+    // Centro e semi-estensione dell'AABB locale
+    const glm::vec2 center = (localMin + localMax) * 0.5f;
+    const glm::vec2 half = (localMax - localMin) * 0.5f;
+
+    // Centro nel sistema di riferimento globale dell'entità
+    const glm::vec2 worldCenter = transform.transformPoint(center);
+
+    // Semi-estensione: |parte lineare| * half (massimo sui quattro angoli)
+    const glm::vec2 worldHalf(
+        std::abs(transform.x.x) * half.x + std::abs(transform.y.x) * half.y,
+        std::abs(transform.x.y) * half.x + std::abs(transform.y.y) * half.y);
+
+    return AABB(worldCenter - worldHalf, worldCenter + worldHalf);
+}
\ No newline at end of file
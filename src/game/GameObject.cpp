@@ -1,112 +1,142 @@
-#include "game/GameObject.h"
-#include <glm/gtc/matrix_transform.hpp>
-#include "game/Collision.h"
-#include "graphics/Mesh.h"
-#include "graphics/MeshManager.h"
-
-int Entity::nextId = 0;
-
-/**
- * @brief Calcola la matrice modello combinando traslazione, rotazione e scala.
- *
- * Usa le funzioni GLM (compatibili con OpenGL) per costruire una Model Matrix:
- *  - `translate` sposta l'oggetto nello spazio;
- *  - `rotate` applica una rotazione sul piano Z;
- *  - `scale` ridimensiona la mesh.
- */
-const glm::mat4 TransformComponent::getModelMatrix() const {
-    glm::mat4 model(1.0f);
-    model = glm::translate(model, glm::vec3(position, 0.0f));
-    model = glm::rotate(model, rotation, glm::vec3(0.0f, 0.0f, 1.0f));
-    model = glm::scale(model, glm::vec3(scale, 1.0f));
-    return model;
-}
-
-// Metodi di modifica del transform (autoesplicativi)
-void TransformComponent::setPosition(const glm::vec2& pos) { position = pos; }
-void TransformComponent::setRotation(float rot) { rotation = rot; }
-void TransformComponent::setScale(const glm::vec2& scl) { scale = scl; }
-void TransformComponent::translate(const glm::vec2& offset) { position += offset; }
-void TransformComponent::rotate(float angle) { rotation += angle; }
-void TransformComponent::scaleBy(const glm::vec2& factor) { scale *= factor; }
-
-void RenderComponent::addSubMesh(SubMeshRenderInfo& meshInfo) {
-    subMeshes.push_back(meshInfo);
-}
-
-const std::vector<SubMeshRenderInfo>& RenderComponent::getSubMeshes() const {
-    return subMeshes;
-}
-
-void RenderComponent::clearSubMesh() {
-    subMeshes.clear();
-}
-
-// ---------- Entity: constructor e gestione layers ----------
-Entity::Entity(const std::string& entityName)
-    : id(nextId++), name(entityName), active(true), transform(), renderData() {
-    // Costruttore: assegna un id univoco, nome e abilita l'entit.
-    // I componenti (transform, renderData) vengono inizializzati con i loro costruttori di default.
-}
-
-void Entity::addMeshLayer(SubMeshRenderInfo meshInfo) {
-    renderData.addSubMesh(meshInfo);
-}
-
-void Entity::clearMeshLayers() {
-    renderData.clearSubMesh();
-}
-
-/*
- * @brief Restituisce l'AABB dell'entit combinando tutte le sub-mesh.
- *
- * Strategia:
- *  - Per ogni SubMesh presente in renderData, otteniamo la Mesh dal MeshManager.
- *  - Calcoliamo l'AABB della mesh applicando la trasformazione globale dell'entit
- *    moltiplicata per la trasformazione locale della sub-mesh.
- *  - Accumuliamo min/max per ottenere l'AABB complessiva dell'entit.
- *
- * Nota: dipende da calculateMeshAABB(mesh, transformMatrix) definita in game/Collision.h.
- */
-AABB Entity::getAABB() const {
-    // Inizializziamo un AABB "vuoto" che si espander via via.
-    AABB result;
-
-    // Se non ci sono submesh, ritorniamo un AABB vuoto (min > max)
-    const auto& subs = renderData.getSubMeshes();
-    if (subs.empty()) {
-        return result;
-    }
-
-    // Trasformazione globale dell'entit (model matrix)
-    glm::mat4 globalModel = transform.getModelMatrix();
-
-    bool first = true;
-    for (const auto& sub : subs) {
-        // Ottieni la mesh dal MeshManager
-        auto meshPtr = MeshManager::getById(sub.meshId);
-        if (meshPtr) {
-            // Componiamo la trasformazione: globale * locale della submesh
-            glm::mat4 composed = globalModel * sub.localTransform;
-
-            // Calcoliamo l'AABB per questa mesh trasformata
-            AABB meshAabb = calculateMeshAABB(meshPtr, composed);
-
-            if (first) {
-                result = meshAabb;
-                first = false;
-            }
-            else {
-                // Espandiamo il risultato con i nuovi min/max
-                result.min.x = std::min(result.min.x, meshAabb.min.x);
-                result.min.y = std::min(result.min.y, meshAabb.min.y);
-                result.max.x = std::max(result.max.x, meshAabb.max.x);
-                result.max.y = std::max(result.max.y, meshAabb.max.y);
-            }
-        }
-
-        
-    }
-
-    return result;
+#include "game/GameObject.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include "game/Collision.h"
+#include "graphics/Mesh.h"
+#include "graphics/MeshManager.h"
+
+/**
+ * @brief Restituisce la matrice modello, ricostruendola solo se il transform è cambiato.
+ *
+ * La matrice è la stessa di translate * rotate(Z) * scale, in forma affine 2D (vedi Affine2D).
+ *
+ * Seno e coseno vengono ricalcolati solo se la rotazione è cambiata.
+ */
+const Affine2D& TransformComponent::getModelMatrix() const {
+    if (dirty) {
+        if (rotation != cachedAngle) {
+            cachedAngle = rotation;
+            cachedSin = std::sin(rotation);
+            cachedCos = std::cos(rotation);
+        }
+
+        modelMatrix = Affine2D::fromTRS(position, cachedSin, cachedCos, scale);
+
+        dirty = false;
+        version++;
+    }
+    return modelMatrix;
+}
+
+/**
+ * @brief Interpola posizione e rotazione; se l'entità è ferma riusa la matrice in cache.
+ */
+Affine2D TransformComponent::getInterpolatedMatrix(float alpha) const {
+    if (!hasMoved() || alpha >= 1.0f) {
+        return getModelMatrix();
+    }
+
+    const glm::vec2 pos = previousPosition + (position - previousPosition) * alpha;
+    const float rot = previousRotation + (rotation - previousRotation) * alpha;
+    return Affine2D::fromTRS(pos, rot, scale);
+}
+
+// Metodi di modifica del transform (autoesplicativi): invalidano la matrice in cache
+void TransformComponent::setPosition(const glm::vec2& pos) { position = pos; dirty = true; }
+void TransformComponent::setRotation(float rot) { rotation = rot; dirty = true; }
+void TransformComponent::setScale(const glm::vec2& scl) { scale = scl; dirty = true; }
+void TransformComponent::translate(const glm::vec2& offset) { position += offset; dirty = true; }
+void TransformComponent::rotate(float angle) { rotation += angle; dirty = true; }
+void TransformComponent::scaleBy(const glm::vec2& factor) { scale *= factor; dirty = true; }
+
+void RenderComponent::addSubMesh(SubMeshRenderInfo& meshInfo) {
+    subMeshes.push_back(meshInfo);
+}
+
+const std::vector<SubMeshRenderInfo>& RenderComponent::getSubMeshes() const {
+    return subMeshes;
+}
+
+void RenderComponent::clearSubMesh() {
+    subMeshes.clear();
+}
+
+// ---------- Entity: constructor e gestione layers ----------
+Entity::Entity(const std::string& entityName, EntityKind entityKind)
+    : name(entityName), active(true), kind(entityKind), transform(), renderData() {
+    // Costruttore: assegna nome, categoria e abilita l'entità (l'handle lo assegna la Scene).
+    // I componenti (transform, renderData) vengono inizializzati con i loro costruttori di default.
+}
+
+void Entity::addMeshLayer(SubMeshRenderInfo meshInfo) {
+    renderData.addSubMesh(meshInfo);
+    subMeshWorldValid = false;
+}
+
+void Entity::clearMeshLayers() {
+    renderData.clearSubMesh();
+    subMeshWorldValid = false;
+}
+
+/*
+ * @brief Restituisce le matrici mondo delle sub-mesh, ricalcolandole solo se necessario.
+ *
+ * La cache è valida se la versione del transform non è cambiata e nessun layer è stato
+ * aggiunto o rimosso: renderer, AABB e debug leggono le stesse matrici.
+ */
+const std::vector<Affine2D>& Entity::getSubMeshWorldMatrices() const {
+    const Affine2D& model = transform.getModelMatrix();
+    const uint32_t version = transform.getVersion();
+    const auto& subs = renderData.getSubMeshes();
+
+    if (!subMeshWorldValid || subMeshWorldVersion != version || subMeshWorld.size() != subs.size()) {
+        subMeshWorld.resize(subs.size());
+        for (size_t i = 0; i < subs.size(); ++i) {
+            subMeshWorld[i] = model * subs[i].localTransform;
+        }
+        subMeshWorldVersion = version;
+        subMeshWorldValid = true;
+    }
+    return subMeshWorld;
+}
+
+/*
+ * @brief Ricalcola l'AABB dell'entità combinando tutte le sub-mesh.
+ *
+ * Strategia:
+ *  - Per ogni SubMesh presente in renderData, otteniamo la Mesh dal MeshManager.
+ *  - Trasformiamo i quattro angoli dell'AABB locale della mesh con la trasformazione
+ *    globale dell'entità moltiplicata per la trasformazione locale della sub-mesh.
+ *  - Accumuliamo min/max per ottenere l'AABB complessiva dell'entità.
+ *
+ * Nota: dipende da calculateMeshAABB(mesh, transformMatrix) definita in game/Collision.h.
+ */
+void Entity::updateBounds() {
+    // Inizializziamo un AABB "vuoto" che si espanderà via via.
+    // Se non ci sono submesh resta vuoto (min > max)
+    worldBounds = AABB();
+
+    const auto& subs = renderData.getSubMeshes();
+    if (subs.empty()) {
+        return;
+    }
+
+    // Trasformazioni globale * locale delle submesh (in cache)
+    const auto& worldMatrices = getSubMeshWorldMatrices();
+
+    for (size_t i = 0; i < subs.size(); ++i) {
+        // Ottieni la mesh dal MeshManager
+        auto meshPtr = MeshManager::getById(subs[i].meshId);
+        if (meshPtr) {
+            // Espandiamo il risultato con l'AABB di questa mesh trasformata
+            worldBounds.expand(calculateMeshAABB(*meshPtr, worldMatrices[i]));
+        }
+    }
+}
+
+/*
+ * @brief Restituisce l'AABB in cache calcolata dall'ultimo updateBounds().
+ */
+AABB Entity::getAABB() const {
+    return worldBounds;
 }
\ No newline at end of file
@@ -1,25 +1,41 @@
-#include "game/Obstacle.h"
-
-Obstacle::Obstacle(const std::string& name, Type type)
-    : Entity(name), type(type) {
-}
-
-/**
- * @brief Aggiorna la posizione e la rotazione dell'ostacolo.
- * Se esce dai limiti dello schermo, viene disattivato.
- */
-void Obstacle::update(float deltaTime) {
-    // Movimento lineare
-    transform.translate(velocity * deltaTime);
-
-    // Rotazione solo per asteroidi
-    if (type == ASTEROID && rotationSpeed != 0.0f) {
-        transform.rotate(rotationSpeed * deltaTime);
-    }
-
-    // Controllo fuori schermo
-    const glm::vec2 pos = transform.getPosition();
-    if (pos.y < -5.0f || pos.x < -5.0f || pos.x > 5.0f) {
-        setActive(false);
-    }
-}
+#include "game/Obstacle.h"
+
+Obstacle::Obstacle(const std::string& name, Type type)
+    : Entity(name, EntityKind::Obstacle), type(type) {
+    collisionLayer = CollisionLayer::Obstacle;
+    collisionMask = CollisionLayer::Player | CollisionLayer::Projectile;
+}
+
+/**
+ * @brief Riporta l'ostacolo allo stato iniziale mantenendo la memoria già allocata.
+ */
+void Obstacle::reset(const std::string& name, Type newType, const glm::vec2& position, const glm::vec2& vel) {
+    setName(name);
+    type = newType;
+    transform.setPosition(position);
+    transform.setRotation(0.0f);
+    transform.setScale(glm::vec2(1.0f));
+    velocity = vel;
+    rotationSpeed = 0.0f;
+    setActive(true);
+}
+
+/**
+ * @brief Aggiorna la posizione e la rotazione dell'ostacolo.
+ * Se esce dai limiti dello schermo, viene disattivato.
+ */
+void Obstacle::update(float deltaTime) {
+    // Movimento lineare
+    transform.translate(velocity * deltaTime);
+
+    // Rotazione solo per asteroidi
+    if (type == ASTEROID && rotationSpeed != 0.0f) {
+        transform.rotate(rotationSpeed * deltaTime);
+    }
+
+    // Controllo fuori schermo
+    const glm::vec2 pos = transform.getPosition();
+    if (pos.y < -5.0f || pos.x < -5.0f || pos.x > 5.0f) {
+        setActive(false);
+    }
+}
@@ -1,39 +1,53 @@
-#include "game/Projectile.h"
-#define GLM_ENABLE_EXPERIMENTAL
-
-#include <glm/gtc/constants.hpp> // glm::pi<float>()
-#include <glm/gtx/norm.hpp>      // glm::length2
-#include <cmath>                 // atan2
-
-Projectile::Projectile(const std::string& name)
-    : Entity(name) {
-}
-
-/**
- * @brief Aggiorna il movimento e la rotazione del proiettile.
- */
-void Projectile::update(float deltaTime) {
-    // 1. Movimento del proiettile
-    transform.translate(velocity * deltaTime);
-
-    // 2. Orientamento dinamico (rotazione nella direzione della velocit)
-    if (glm::length2(velocity) > 0.0001f) {
-        float targetAngle = std::atan2(velocity.y, velocity.x);
-
-        // Se il modello  orientato lungo Y (UP) a rotazione 0, ruotiamo di -90
-        transform.setRotation(targetAngle - glm::pi<float>() * 0.5f);
-    }
-
-    // 3. Riduzione del lifetime
-    lifetime -= deltaTime;
-    if (lifetime <= 0.0f) {
-        setActive(false);
-        return;
-    }
-
-    // 4. Disattivazione se fuori schermo
-    const glm::vec2 pos = transform.getPosition();
-    if (pos.x < -5.0f || pos.x > 5.0f || pos.y < -5.0f || pos.y > 5.0f) {
-        setActive(false);
-    }
-}
+#include "game/Projectile.h"
+#define GLM_ENABLE_EXPERIMENTAL
+
+#include <glm/gtc/constants.hpp> // glm::pi<float>()
+#include <glm/gtx/norm.hpp>      // glm::length2
+#include <cmath>                 // atan2
+
+Projectile::Projectile(const std::string& name)
+    : Entity(name, EntityKind::Projectile) {
+    collisionLayer = CollisionLayer::Projectile;
+    collisionMask = CollisionLayer::Obstacle;
+}
+
+/**
+ * @brief Riporta il proiettile allo stato iniziale mantenendo la memoria già allocata.
+ */
+void Projectile::reset(const glm::vec2& position, const glm::vec2& vel, float lt) {
+    transform.setPosition(position);
+    transform.setRotation(0.0f);
+    transform.setScale(glm::vec2(1.0f));
+    velocity = vel;
+    lifetime = lt;
+    setActive(true);
+}
+
+/**
+ * @brief Aggiorna il movimento e la rotazione del proiettile.
+ */
+void Projectile::update(float deltaTime) {
+    // 1. Movimento del proiettile
+    transform.translate(velocity * deltaTime);
+
+    // 2. Orientamento dinamico (rotazione nella direzione della velocità)
+    if (glm::length2(velocity) > 0.0001f) {
+        float targetAngle = std::atan2(velocity.y, velocity.x);
+
+        // Se il modello è orientato lungo Y (UP) a rotazione 0, ruotiamo di -90°
+        transform.setRotation(targetAngle - glm::pi<float>() * 0.5f);
+    }
+
+    // 3. Riduzione del lifetime
+    lifetime -= deltaTime;
+    if (lifetime <= 0.0f) {
+        setActive(false);
+        return;
+    }
+
+    // 4. Disattivazione se fuori schermo
+    const glm::vec2 pos = transform.getPosition();
+    if (pos.x < -5.0f || pos.x > 5.0f || pos.y < -5.0f || pos.y > 5.0f) {
+        setActive(false);
+    }
+}
@@ -0,0 +1,56 @@
+#include "graphics/BackgroundPass.h"
+#include <algorithm>
+#include <cmath>
+
+bool BackgroundPass::begin(int outputWidth, int outputHeight, unsigned int shaderId) {
+    gpuTimer.begin();
+
+    if (shaderId != lastShaderId) {
+        lastShaderId = shaderId;
+        dirty = true;
+    }
+
+    if (!isOffscreen()) {
+        // Piena risoluzione a ogni frame: l'FBO sarebbe solo una copia in più
+        targetSize = glm::ivec2(outputWidth, outputHeight);
+        dirty = true;
+        refreshed = true;
+        return true;
+    }
+
+    const int width = std::max(1, static_cast<int>(std::lround(outputWidth * scale)));
+    const int height = std::max(1, static_cast<int>(std::lround(outputHeight * scale)));
+    if (target.resize(width, height)) dirty = true;
+    targetSize = glm::ivec2(width, height);
+
+    refreshed = dirty || ++framesSinceRefresh >= refreshInterval;
+    if (!refreshed) return false;
+
+    framesSinceRefresh = 0;
+    dirty = false;
+    target.bind();
+    glClear(GL_COLOR_BUFFER_BIT);
+    return true;
+}
+
+void BackgroundPass::end(const RenderTarget* output, int outputWidth, int outputHeight) {
+    if (isOffscreen()) {
+        RenderTarget::bindOrDefault(output, outputWidth, outputHeight);
+        target.blitTo(output, outputWidth, outputHeight, GL_LINEAR);
+    }
+
+    gpuTimer.end();
+}
+
+void BackgroundPass::setScale(float newScale) {
+    if (newScale < MIN_SCALE) newScale = MIN_SCALE;
+    if (newScale > MAX_SCALE) newScale = MAX_SCALE;
+    if (newScale != scale) dirty = true;
+    scale = newScale;
+}
+
+void BackgroundPass::setRefreshInterval(int frames) {
+    if (frames < 1) frames = 1;
+    if (frames > MAX_REFRESH_INTERVAL) frames = MAX_REFRESH_INTERVAL;
+    refreshInterval = frames;
+}
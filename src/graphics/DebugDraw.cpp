@@ -0,0 +1,78 @@
+#include "graphics/DebugDraw.h"
+#include <algorithm>
+#include <cmath>
+#include "graphics/Vertex.h"
+#include "graphics/Shader.h"
+#include "graphics/ShaderManager.h"
+
+namespace {
+    /// Capacità iniziale del VBO, in segmenti (cresce raddoppiando)
+    constexpr unsigned int INITIAL_LINE_CAPACITY = 1024;
+}
+
+DebugDraw::DebugDraw() = default;
+DebugDraw::~DebugDraw() = default;
+
+void DebugDraw::line(const glm::vec2& a, const glm::vec2& b, const glm::vec4& color) {
+    vertices.push_back({ a, color });
+    vertices.push_back({ b, color });
+}
+
+void DebugDraw::box(const AABB& box, const glm::vec4& color) {
+    const glm::vec2 bottomRight(box.max.x, box.min.y);
+    const glm::vec2 topLeft(box.min.x, box.max.y);
+
+    line(box.min, bottomRight, color);
+    line(bottomRight, box.max, color);
+    line(box.max, topLeft, color);
+    line(topLeft, box.min, color);
+}
+
+void DebugDraw::circle(const glm::vec2& center, float radius, const glm::vec4& color, int segments) {
+    segments = std::max(3, segments);
+    const float step = 6.28318530718f / static_cast<float>(segments);
+
+    glm::vec2 previous = center + glm::vec2(radius, 0.0f);
+    for (int i = 1; i <= segments; ++i) {
+        const float angle = step * static_cast<float>(i);
+        const glm::vec2 next = center + radius * glm::vec2(std::cos(angle), std::sin(angle));
+        line(previous, next, color);
+        previous = next;
+    }
+}
+
+/**
+ * @brief Un upload (glBufferData orfano + glBufferSubData) e una glDrawArrays per tutto il frame.
+ */
+unsigned int DebugDraw::flush() {
+    lastLineCount = static_cast<unsigned int>(vertices.size() / 2);
+    if (vertices.empty()) return 0;
+
+    std::shared_ptr<Shader> shader = ShaderManager::get("DebugLineShader");
+    if (!shader) {
+        vertices.clear();
+        return 0;
+    }
+
+    if (!vao) {
+        vbo = std::make_unique<vrtx::VertexBuffer>(
+            static_cast<unsigned int>(INITIAL_LINE_CAPACITY * 2 * sizeof(LineVertex)));
+        vao = std::make_unique<vrtx::VertexArray>();
+
+        vrtx::VertexBufferLayout layout;
+        layout.push<float>(2); // posizione
+        layout.push<float>(4); // colore
+
+        vao->bind();
+        vao->addBuffer(*vbo, layout);
+    }
+
+    vbo->update(vertices.data(), static_cast<unsigned int>(vertices.size() * sizeof(LineVertex)));
+
+    shader->bind();
+    vao->bind();
+    glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(vertices.size()));
+
+    vertices.clear();
+    return 1;
+}
@@ -0,0 +1,73 @@
+#include "graphics/DynamicResolution.h"
+#include <algorithm>
+#include <cmath>
+
+void DynamicResolution::begin(int screenWidth, int screenHeight) {
+    gpuTimer.begin();
+
+    offscreen = enabled && scale < MAX_SCALE;
+    if (!offscreen) {
+        renderSize = glm::ivec2(screenWidth, screenHeight);
+        RenderTarget::bindDefault(screenWidth, screenHeight);
+        return;
+    }
+
+    const int width = std::max(1, static_cast<int>(std::lround(screenWidth * scale)));
+    const int height = std::max(1, static_cast<int>(std::lround(screenHeight * scale)));
+    target.resize(width, height);
+    renderSize = glm::ivec2(width, height);
+    target.bind();
+}
+
+void DynamicResolution::end(int screenWidth, int screenHeight) {
+    if (offscreen) {
+        RenderTarget::bindDefault(screenWidth, screenHeight);
+        target.blitToScreen(screenWidth, screenHeight, GL_LINEAR);
+    }
+
+    gpuTimer.end();
+    if (enabled) adjustScale();
+}
+
+void DynamicResolution::setEnabled(bool value) {
+    enabled = value;
+    if (!enabled) scale = MAX_SCALE;
+    framesOverBudget = 0;
+    framesUnderBudget = 0;
+}
+
+void DynamicResolution::adjustScale() {
+    const float frameMilliseconds = gpuTimer.getMilliseconds();
+    if (frameMilliseconds <= 0.0f) return;  // Nessuna misura ancora disponibile
+    if (settleFrames > 0) {
+        --settleFrames;
+        return;
+    }
+
+    if (frameMilliseconds > budgetMilliseconds) {
+        framesUnderBudget = 0;
+        if (++framesOverBudget < SHRINK_FRAMES) return;
+
+        const float minScale = MIN_SCALE;
+        scale = std::max(minScale, scale - SHRINK_STEP);
+    }
+    else if (frameMilliseconds < budgetMilliseconds * GROW_HEADROOM) {
+        framesOverBudget = 0;
+        if (++framesUnderBudget < GROW_FRAMES) return;
+
+        const float maxScale = MAX_SCALE;
+        scale = std::min(maxScale, scale + GROW_STEP);
+    }
+    else {
+        // Dentro la fascia di isteresi: la scala corrente va bene
+        framesOverBudget = 0;
+        framesUnderBudget = 0;
+        return;
+    }
+
+    // Riallinea ai passi di 0.05 per evitare derive di arrotondamento (es. 0.9999 invece di 1)
+    scale = std::round(scale * 20.0f) / 20.0f;
+    framesOverBudget = 0;
+    framesUnderBudget = 0;
+    settleFrames = SETTLE_FRAMES;
+}
@@ -0,0 +1,157 @@
+#include "graphics/GLStateCache.h"
+
+namespace {
+    // Valore "sconosciuto": nessun ID OpenGL valido lo assume
+    constexpr GLuint UNKNOWN = 0xFFFFFFFFu;
+    constexpr GLenum UNKNOWN_ENUM = 0xFFFFFFFFu;
+
+    /// Stato collegato lato driver, per quanto ne sa la cache
+    struct CachedState {
+        GLuint program = UNKNOWN;
+        GLuint vertexArray = UNKNOWN;
+        GLuint arrayBuffer = UNKNOWN;
+        GLuint elementBuffer = UNKNOWN;
+        GLuint uniformBuffer = UNKNOWN;
+        int blend = -1; ///< -1 sconosciuto, 0 disabilitato, 1 abilitato
+        GLenum blendSource = UNKNOWN_ENUM;
+        GLenum blendDestination = UNKNOWN_ENUM;
+        int depthTest = -1;  ///< -1 sconosciuto, 0 disabilitato, 1 abilitato
+        int depthWrite = -1; ///< -1 sconosciuto, 0 disabilitata, 1 abilitata
+        GLenum polygonMode = UNKNOWN_ENUM;
+    };
+
+    CachedState cached;
+    GLStateStats current;
+    GLStateStats lastFrame;
+}
+
+void GLStateCache::countState(bool issued) {
+    if (issued) current.stateIssued++;
+    else current.stateElided++;
+}
+
+void GLStateCache::countUniform(bool issued) {
+    if (issued) current.uniformsIssued++;
+    else current.uniformsElided++;
+}
+
+void GLStateCache::useProgram(GLuint program) {
+    const bool changed = cached.program != program;
+    if (changed) {
+        glUseProgram(program);
+        cached.program = program;
+    }
+    countState(changed);
+}
+
+void GLStateCache::bindVertexArray(GLuint vao) {
+    const bool changed = cached.vertexArray != vao;
+    if (changed) {
+        glBindVertexArray(vao);
+        cached.vertexArray = vao;
+        cached.elementBuffer = UNKNOWN; // l'IBO collegato appartiene al VAO
+    }
+    countState(changed);
+}
+
+void GLStateCache::bindBuffer(GLenum target, GLuint buffer) {
+    GLuint* slot = nullptr;
+    switch (target) {
+    case GL_ARRAY_BUFFER:         slot = &cached.arrayBuffer; break;
+    case GL_ELEMENT_ARRAY_BUFFER: slot = &cached.elementBuffer; break;
+    case GL_UNIFORM_BUFFER:       slot = &cached.uniformBuffer; break;
+    default:
+        glBindBuffer(target, buffer);
+        countState(true);
+        return;
+    }
+
+    const bool changed = *slot != buffer;
+    if (changed) {
+        glBindBuffer(target, buffer);
+        *slot = buffer;
+    }
+    countState(changed);
+}
+
+void GLStateCache::setBlend(bool enabled) {
+    const int value = enabled ? 1 : 0;
+    const bool changed = cached.blend != value;
+    if (changed) {
+        if (enabled) glEnable(GL_BLEND);
+        else glDisable(GL_BLEND);
+        cached.blend = value;
+    }
+    countState(changed);
+}
+
+void GLStateCache::setBlendFunc(GLenum sourceFactor, GLenum destinationFactor) {
+    const bool changed = cached.blendSource != sourceFactor || cached.blendDestination != destinationFactor;
+    if (changed) {
+        glBlendFunc(sourceFactor, destinationFactor);
+        cached.blendSource = sourceFactor;
+        cached.blendDestination = destinationFactor;
+    }
+    countState(changed);
+}
+
+void GLStateCache::setDepthTest(bool enabled) {
+    const int value = enabled ? 1 : 0;
+    const bool changed = cached.depthTest != value;
+    if (changed) {
+        if (enabled) glEnable(GL_DEPTH_TEST);
+        else glDisable(GL_DEPTH_TEST);
+        cached.depthTest = value;
+    }
+    countState(changed);
+}
+
+void GLStateCache::setDepthWrite(bool enabled) {
+    const int value = enabled ? 1 : 0;
+    const bool changed = cached.depthWrite != value;
+    if (changed) {
+        glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+        cached.depthWrite = value;
+    }
+    countState(changed);
+}
+
+void GLStateCache::setPolygonMode(GLenum mode) {
+    const bool changed = cached.polygonMode != mode;
+    if (changed) {
+        glPolygonMode(GL_FRONT_AND_BACK, mode);
+        cached.polygonMode = mode;
+    }
+    countState(changed);
+}
+
+void GLStateCache::onProgramDeleted(GLuint program) {
+    if (cached.program == program) cached.program = UNKNOWN;
+}
+
+void GLStateCache::onVertexArrayDeleted(GLuint vao) {
+    if (cached.vertexArray == vao) {
+        cached.vertexArray = UNKNOWN;
+        cached.elementBuffer = UNKNOWN;
+    }
+}
+
+void GLStateCache::onBufferDeleted(GLuint buffer) {
+    // Eliminare un buffer collegato lo scollega dal punto di binding
+    if (cached.arrayBuffer == buffer) cached.arrayBuffer = UNKNOWN;
+    if (cached.elementBuffer == buffer) cached.elementBuffer = UNKNOWN;
+    if (cached.uniformBuffer == buffer) cached.uniformBuffer = UNKNOWN;
+}
+
+void GLStateCache::invalidate() {
+    cached = CachedState();
+}
+
+void GLStateCache::beginFrame() {
+    lastFrame = current;
+    current = GLStateStats();
+}
+
+const GLStateStats& GLStateCache::getLastFrameStats() {
+    return lastFrame;
+}
@@ -0,0 +1,202 @@
+#include "graphics/GeometryArena.h"
+#include <algorithm>
+#include <cstdint>
+#include "graphics/Vertex.h"
+#include "graphics/GLStateCache.h"
+
+namespace {
+    /// Capacità iniziali: bastano per navicelle, ostacoli e HUD senza crescere
+    constexpr unsigned int INITIAL_VERTEX_CAPACITY = 64 * 1024;
+    constexpr unsigned int INITIAL_INDEX_BYTE_CAPACITY = 512 * 1024;
+
+    constexpr int FORMAT_COUNT = static_cast<int>(VertexFormat::Count);
+
+    unsigned int indexSize(GLenum indexType) {
+        return indexType == GL_UNSIGNED_SHORT ? 2u : 4u;
+    }
+}
+
+GeometryArena::~GeometryArena() {
+    if (indexBuffer == 0) return;
+
+    for (VertexPool& pool : pools) {
+        GLStateCache::onBufferDeleted(pool.buffer);
+        GLStateCache::onVertexArrayDeleted(pool.vao);
+        glDeleteBuffers(1, &pool.buffer);
+        glDeleteVertexArrays(1, &pool.vao);
+    }
+    GLStateCache::onBufferDeleted(indexBuffer);
+    glDeleteBuffers(1, &indexBuffer);
+}
+
+unsigned int GeometryArena::getVertexSize(VertexFormat format) {
+    return format == VertexFormat::Snorm16x2 ? 2 * sizeof(int16_t) : 2 * sizeof(float);
+}
+
+void GeometryArena::create() {
+    glGenBuffers(1, &indexBuffer);
+    indexByteCapacity = INITIAL_INDEX_BYTE_CAPACITY;
+
+    for (int f = 0; f < FORMAT_COUNT; ++f) {
+        VertexPool& pool = pools[f];
+        glGenVertexArrays(1, &pool.vao);
+        glGenBuffers(1, &pool.buffer);
+        pool.capacity = INITIAL_VERTEX_CAPACITY;
+
+        GLStateCache::bindBuffer(GL_ARRAY_BUFFER, pool.buffer);
+        glBufferData(GL_ARRAY_BUFFER,
+            static_cast<GLsizeiptr>(pool.capacity) * getVertexSize(static_cast<VertexFormat>(f)),
+            nullptr, GL_STATIC_DRAW);
+
+        setupVertexArray(static_cast<VertexFormat>(f));
+    }
+
+    // Il buffer degli indici è collegato all'ultimo VAO configurato
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexByteCapacity, nullptr, GL_STATIC_DRAW);
+}
+
+void GeometryArena::setupVertexArray(VertexFormat format) {
+    const VertexPool& pool = pools[static_cast<int>(format)];
+    GLStateCache::bindVertexArray(pool.vao);
+    GLStateCache::bindBuffer(GL_ARRAY_BUFFER, pool.buffer);
+    glEnableVertexAttribArray(0);
+
+    // Le posizioni quantizzate vengono normalizzate in [-1, 1]: i bound della mesh
+    // (applicati dal Renderer nella matrice model) le riportano in spazio locale
+    if (format == VertexFormat::Snorm16x2)
+        glVertexAttribPointer(0, 2, GL_SHORT, GL_TRUE, getVertexSize(format), nullptr);
+    else
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, getVertexSize(format), nullptr);
+
+    GLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+}
+
+/**
+ * @brief Crea un buffer più grande, vi copia la parte occupata e sostituisce il vecchio.
+ *
+ * La copia avviene tramite i target GL_COPY_READ_BUFFER / GL_COPY_WRITE_BUFFER, che non
+ * toccano i binding usati per il disegno. Il chiamante deve ricollegare i VAO.
+ */
+void GeometryArena::grow(GLuint& buffer, unsigned int& capacity, unsigned int used,
+    unsigned int required, unsigned int elementSize) {
+    unsigned int newCapacity = std::max(1u, capacity);
+    while (newCapacity < required) newCapacity *= 2;
+
+    GLuint newBuffer = 0;
+    glGenBuffers(1, &newBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(newCapacity) * elementSize, nullptr, GL_STATIC_DRAW);
+
+    if (used > 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+            static_cast<GLsizeiptr>(used) * elementSize);
+    }
+
+    GLStateCache::onBufferDeleted(buffer);
+    glDeleteBuffers(1, &buffer);
+    buffer = newBuffer;
+    capacity = newCapacity;
+    growths++;
+}
+
+MeshRange GeometryArena::allocate(VertexFormat format, const void* vertexData, unsigned int vertexCount,
+    GLenum indexType, const void* indexData, unsigned int indexCount) {
+    if (indexBuffer == 0) create();
+
+    VertexPool& pool = pools[static_cast<int>(format)];
+    const unsigned int vertexSize = getVertexSize(format);
+    const unsigned int elementSize = indexSize(indexType);
+
+    MeshRange range;
+    range.format = format;
+    range.indexType = indexType;
+    range.baseVertex = pool.count;
+    range.vertexCount = vertexCount;
+    range.indexCount = indexCount;
+
+    // Gli indici a 32 bit devono partire da un offset multiplo di 4
+    range.indexOffset = (indexBytes + elementSize - 1) / elementSize * elementSize;
+    const unsigned int indexEnd = range.indexOffset + indexCount * elementSize;
+
+    if (pool.count + vertexCount > pool.capacity) {
+        grow(pool.buffer, pool.capacity, pool.count, pool.count + vertexCount, vertexSize);
+        setupVertexArray(format);
+    }
+    if (indexEnd > indexByteCapacity) {
+        grow(indexBuffer, indexByteCapacity, indexBytes, indexEnd, 1);
+        for (int f = 0; f < FORMAT_COUNT; ++f) {
+            setupVertexArray(static_cast<VertexFormat>(f));
+        }
+    }
+
+    GLStateCache::bindVertexArray(pool.vao);
+    if (vertexCount > 0) {
+        GLStateCache::bindBuffer(GL_ARRAY_BUFFER, pool.buffer);
+        glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(range.baseVertex) * vertexSize,
+            static_cast<GLsizeiptr>(vertexCount) * vertexSize, vertexData);
+    }
+    if (indexCount > 0) {
+        GLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, range.indexOffset,
+            static_cast<GLsizeiptr>(indexCount) * elementSize, indexData);
+    }
+
+    pool.count += vertexCount;
+    indexBytes = indexEnd;
+    meshCount++;
+    if (format == VertexFormat::Snorm16x2) quantizedMeshes++;
+    if (indexType == GL_UNSIGNED_SHORT) shortIndexMeshes++;
+    return range;
+}
+
+void GeometryArena::bind(VertexFormat format) const {
+    GLStateCache::bindVertexArray(pools[static_cast<int>(format)].vao);
+}
+
+void GeometryArena::draw(const MeshRange& range, GLenum mode) const {
+    if (range.indexCount == 0) return;
+
+    glDrawElementsBaseVertex(mode, static_cast<GLsizei>(range.indexCount), range.indexType,
+        reinterpret_cast<const void*>(static_cast<uintptr_t>(range.indexOffset)),
+        static_cast<GLint>(range.baseVertex));
+}
+
+void GeometryArena::drawInstanced(const MeshRange& range, GLenum mode, unsigned int instanceCount) const {
+    if (range.indexCount == 0 || instanceCount == 0
+        || !pools[static_cast<int>(range.format)].instanceBuffer) return;
+
+    glDrawElementsInstancedBaseVertex(mode, static_cast<GLsizei>(range.indexCount), range.indexType,
+        reinterpret_cast<const void*>(static_cast<uintptr_t>(range.indexOffset)),
+        static_cast<GLsizei>(instanceCount), static_cast<GLint>(range.baseVertex));
+}
+
+bool GeometryArena::attachInstanceBuffer(VertexFormat format, const vrtx::VertexBuffer& buffer,
+    const vrtx::VertexBufferLayout& layout, unsigned int firstLocation) {
+    VertexPool& pool = pools[static_cast<int>(format)];
+    if (pool.vao == 0 || pool.instanceBuffer == &buffer) return false;
+
+    // Gli attributi per istanza leggono dal buffer indicato: la crescita dei buffer
+    // delle mesh (setupVertexArray) non li modifica
+    GLStateCache::bindVertexArray(pool.vao);
+    vrtx::VertexArray::setAttributes(buffer, layout, firstLocation, 1);
+    buffer.unbind();
+    pool.instanceBuffer = &buffer;
+    return true;
+}
+
+GeometryArenaStats GeometryArena::getStats() const {
+    GeometryArenaStats stats;
+    for (int f = 0; f < FORMAT_COUNT; ++f) {
+        const unsigned int vertexSize = getVertexSize(static_cast<VertexFormat>(f));
+        stats.vertexBytes += pools[f].count * vertexSize;
+        stats.vertexByteCapacity += pools[f].capacity * vertexSize;
+    }
+    stats.indexBytes = indexBytes;
+    stats.indexByteCapacity = indexByteCapacity;
+    stats.meshCount = meshCount;
+    stats.quantizedMeshes = quantizedMeshes;
+    stats.shortIndexMeshes = shortIndexMeshes;
+    stats.growths = growths;
+    return stats;
+}
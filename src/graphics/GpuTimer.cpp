@@ -0,0 +1,49 @@
+#include "graphics/GpuTimer.h"
+
+GpuTimer::~GpuTimer() {
+    if (!created) return;
+    glDeleteQueries(QUERY_COUNT, startQueries);
+    glDeleteQueries(QUERY_COUNT, endQueries);
+}
+
+void GpuTimer::begin() {
+    if (!created) {
+        glGenQueries(QUERY_COUNT, startQueries);
+        glGenQueries(QUERY_COUNT, endQueries);
+        created = true;
+    }
+
+    // La query da riusare è la più vecchia: se il risultato non è ancora arrivato lo si scarta
+    pending[current] = false;
+    glQueryCounter(startQueries[current], GL_TIMESTAMP);
+}
+
+void GpuTimer::end() {
+    if (!created) return;
+
+    glQueryCounter(endQueries[current], GL_TIMESTAMP);
+    pending[current] = true;
+    current = (current + 1) % QUERY_COUNT;
+
+    // Legge, senza attendere, le query completate a partire dalla più vecchia
+    for (int k = 0; k < QUERY_COUNT; ++k) {
+        const int index = (current + k) % QUERY_COUNT;
+        if (!pending[index]) continue;
+
+        GLint available = 0;
+        glGetQueryObjectiv(endQueries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) break;
+
+        // Il timestamp finale segue quello iniziale: se è pronto lo è anche l'altro
+        GLuint64 startNs = 0;
+        GLuint64 endNs = 0;
+        glGetQueryObjectui64v(startQueries[index], GL_QUERY_RESULT, &startNs);
+        glGetQueryObjectui64v(endQueries[index], GL_QUERY_RESULT, &endNs);
+        pending[index] = false;
+
+        lastMilliseconds = endNs > startNs ? static_cast<float>(endNs - startNs) * 1e-6f : 0.0f;
+        averageMilliseconds = averageMilliseconds > 0.0f
+            ? averageMilliseconds * 0.9f + lastMilliseconds * 0.1f
+            : lastMilliseconds;
+    }
+}
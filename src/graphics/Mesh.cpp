@@ -1,55 +1,168 @@
-#include "graphics/Mesh.h"
-#include "graphics/Shader.h"
-#include "graphics/Renderer.h"
-
-Mesh::Mesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices)
-    : vertices(vertices), indices(indices)
-{
-    setupMesh();
-}
-
-void Mesh::setupMesh() {
-    // Crea i buffer principali (VAO, VBO, IBO)
-    va = std::make_unique<vrtx::VertexArray>();
-    unsigned int vertexDataBytes = static_cast<unsigned int>(vertices.size() * sizeof(float));
-    vb = std::make_unique<vrtx::VertexBuffer>(vertices.data(), vertexDataBytes);
-    ib = std::make_unique<vrtx::IndexBuffer>(indices.data(), static_cast<unsigned int>(indices.size()));
-
-    // Layout dei vertici: solo posizione (3 float per vertice)
-    vrtx::VertexBufferLayout layout;
-    layout.push<float>(3); // posizione: x, y, z
-
-    // Collega buffer e layout all'array dei vertici
-    va->bind();
-    vb->bind();
-    va->addBuffer(*vb, layout);
-    ib->bind();
-
-    // Pulizia
-    va->unbind();
-    vb->unbind();
-    ib->unbind();
-}
-
-void Mesh::setVertices(const std::vector<float>& verts) {
-    vertices = verts;
-    setupMesh(); // Ricrea i buffer
-}
-
-void Mesh::setIndices(const std::vector<unsigned int>& inds) {
-    indices = inds;
-    setupMesh(); // Ricrea i buffer
-}
-
-void Mesh::draw(Shader& shader, GLenum usage) const {
-    if (!va || !ib) return; // Se la mesh non  inizializzata, non disegnare
-
-    va->bind();
-    ib->bind();
-
-    // Esegue il disegno con gli indici
-    glDrawElements(usage, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, nullptr);
-
-    ib->unbind();
-    va->unbind();
-}
+#include "graphics/Mesh.h"
+#include "graphics/Shader.h"
+#include "graphics/MeshManager.h"
+#include "graphics/GLStateCache.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace {
+    /// Errore massimo (in unità locali) accettato per quantizzare le posizioni a 16 bit
+    constexpr float QUANTIZATION_TOLERANCE = 1e-4f;
+
+    constexpr float SNORM16_MAX = 32767.0f;
+}
+
+Mesh::Mesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices)
+    : vertices(vertices), indices(indices)
+{
+    computeBounds();
+    setupMesh();
+}
+
+void Mesh::computeBounds() {
+    if (vertices.size() < 3) return;
+
+    // Layout: x, y, z per vertice (z ignorato, il mondo è 2D)
+    minPoint = maxPoint = glm::vec2(vertices[0], vertices[1]);
+    for (size_t i = 3; i + 1 < vertices.size(); i += 3) {
+        glm::vec2 p(vertices[i], vertices[i + 1]);
+        minPoint = glm::min(minPoint, p);
+        maxPoint = glm::max(maxPoint, p);
+    }
+
+    // Raggio: distanza massima dal centro dell'AABB
+    const glm::vec2 center = getBoundsCenter();
+    float maxDist2 = 0.0f;
+    for (size_t i = 0; i + 1 < vertices.size(); i += 3) {
+        glm::vec2 d = glm::vec2(vertices[i], vertices[i + 1]) - center;
+        maxDist2 = std::max(maxDist2, glm::dot(d, d));
+    }
+    boundingRadius = std::sqrt(maxDist2);
+}
+
+/**
+ * @brief Sceglie formato dei vertici e tipo degli indici, codifica i dati e li copia nell'arena.
+ *
+ * Il formato in ingresso ha 3 float per vertice; sulla GPU la z (sempre 0 nel mondo 2D)
+ * non viene caricata. Le posizioni diventano short normalizzati rispetto all'AABB locale
+ * quando l'errore di arrotondamento (metà passo di quantizzazione) resta sotto
+ * QUANTIZATION_TOLERANCE; la trasformazione inversa viene salvata in `dequantization`.
+ * Gli indici passano a 16 bit quando la mesh ha al più 65536 vertici.
+ */
+void Mesh::setupMesh() {
+    const size_t vertexCount = vertices.size() / 3;
+
+    glm::vec2 low(0.0f), high(0.0f);
+    if (vertexCount > 0) {
+        low = high = glm::vec2(vertices[0], vertices[1]);
+        for (size_t v = 1; v < vertexCount; ++v) {
+            const glm::vec2 p(vertices[v * 3], vertices[v * 3 + 1]);
+            low = glm::min(low, p);
+            high = glm::max(high, p);
+        }
+    }
+    const glm::vec2 center = (low + high) * 0.5f;
+    glm::vec2 halfExtent = (high - low) * 0.5f;
+    if (halfExtent.x <= 0.0f) halfExtent.x = 1.0f; // asse degenere: tutte le coordinate a 0
+    if (halfExtent.y <= 0.0f) halfExtent.y = 1.0f;
+
+    const float quantizationError = 0.5f * std::max(halfExtent.x, halfExtent.y) / SNORM16_MAX;
+    const VertexFormat format = quantizationError <= QUANTIZATION_TOLERANCE
+        ? VertexFormat::Snorm16x2
+        : VertexFormat::Float2;
+
+    std::vector<int16_t> packedShorts;
+    std::vector<float> packedFloats;
+    const void* vertexData = nullptr;
+
+    if (format == VertexFormat::Snorm16x2) {
+        packedShorts.resize(vertexCount * 2);
+        for (size_t v = 0; v < vertexCount; ++v) {
+            for (int c = 0; c < 2; ++c) {
+                const float normalized = (vertices[v * 3 + c] - center[c]) / halfExtent[c];
+                const float clamped = std::min(1.0f, std::max(-1.0f, normalized));
+                packedShorts[v * 2 + c] = static_cast<int16_t>(std::lround(clamped * SNORM16_MAX));
+            }
+        }
+        vertexData = packedShorts.data();
+        dequantization = Affine2D::translation(center) * Affine2D::scaling(halfExtent);
+    }
+    else {
+        packedFloats.resize(vertexCount * 2);
+        for (size_t v = 0; v < vertexCount; ++v) {
+            packedFloats[v * 2] = vertices[v * 3];
+            packedFloats[v * 2 + 1] = vertices[v * 3 + 1];
+        }
+        vertexData = packedFloats.data();
+        dequantization = Affine2D::identity();
+    }
+
+    GeometryArena& arena = MeshManager::getArena();
+    if (vertexCount <= static_cast<size_t>(std::numeric_limits<uint16_t>::max()) + 1) {
+        std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+        range = arena.allocate(format, vertexData, static_cast<unsigned int>(vertexCount),
+            GL_UNSIGNED_SHORT, shortIndices.data(), static_cast<unsigned int>(shortIndices.size()));
+    }
+    else {
+        range = arena.allocate(format, vertexData, static_cast<unsigned int>(vertexCount),
+            GL_UNSIGNED_INT, indices.data(), static_cast<unsigned int>(indices.size()));
+    }
+    uploaded = true;
+}
+
+void Mesh::setVertices(const std::vector<float>& verts) {
+    vertices = verts;
+    computeBounds();
+    setupMesh(); // Ricrea i buffer
+}
+
+void Mesh::setIndices(const std::vector<unsigned int>& inds) {
+    indices = inds;
+    setupMesh(); // Ricrea i buffer
+}
+
+void Mesh::draw(Shader& shader, GLenum usage) const {
+    if (!uploaded) return; // Se la mesh non è inizializzata, non disegnare
+
+    // Il VAO resta collegato: tutte le mesh condividono quello dell'arena
+    bind();
+    drawElements(usage);
+}
+
+void Mesh::bind() const {
+    if (!uploaded) return;
+
+    MeshManager::getArena().bind(range.format);
+}
+
+void Mesh::unbind() const {
+    GLStateCache::bindVertexArray(0);
+}
+
+void Mesh::drawElements(GLenum usage) const {
+    if (!uploaded) return;
+
+    // Indici relativi alla mesh, spostati di range.baseVertex
+    MeshManager::getArena().draw(range, usage);
+}
+
+bool Mesh::attachInstanceBuffer(const vrtx::VertexBuffer& buffer, const vrtx::VertexBufferLayout& layout) {
+    if (!uploaded) return false;
+
+    return MeshManager::getArena().attachInstanceBuffer(range.format, buffer, layout, INSTANCE_ATTRIBUTE_LOCATION);
+}
+
+void Mesh::drawInstanced(GLenum usage, unsigned int instanceCount) const {
+    if (!uploaded) return;
+
+    bind();
+    drawElementsInstanced(usage, instanceCount);
+}
+
+void Mesh::drawElementsInstanced(GLenum usage, unsigned int instanceCount) const {
+    if (!uploaded) return;
+
+    MeshManager::getArena().drawInstanced(range, usage, instanceCount);
+}
@@ -0,0 +1,182 @@
+#include "graphics/ProgramCache.h"
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+// GL_ARB_get_program_binary: assente dal loader GLAD 3.3 del progetto
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
+namespace {
+    typedef void (APIENTRYP GetProgramBinaryProc)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+    typedef void (APIENTRYP ProgramBinaryProc)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+    typedef void (APIENTRYP ProgramParameteriProc)(GLuint program, GLenum pname, GLint value);
+
+    GetProgramBinaryProc getProgramBinary = nullptr;
+    ProgramBinaryProc programBinary = nullptr;
+    ProgramParameteriProc programParameteri = nullptr;
+
+    constexpr uint32_t FILE_MAGIC = 0x42504353u; // "SCPB"
+    constexpr uint32_t FILE_VERSION = 1;
+
+    /// Intestazione dei file della cache, seguita da `length` byte di binario
+    struct CacheHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t key;
+        uint32_t format;
+        uint32_t length;
+    };
+
+    uint64_t fnv1a64(const char* data, size_t size, uint64_t value = 14695981039346656037ull) {
+        for (size_t i = 0; i < size; ++i) {
+            value = (value ^ static_cast<uint8_t>(data[i])) * 1099511628211ull;
+        }
+        return value;
+    }
+
+    uint64_t hashGLString(GLenum name, uint64_t value) {
+        const char* text = reinterpret_cast<const char*>(glGetString(name));
+        if (!text) return value;
+        // Il separatore evita che "ab" + "c" e "a" + "bc" diano lo stesso hash
+        value = fnv1a64(text, std::strlen(text), value);
+        return fnv1a64("\n", 1, value);
+    }
+
+    void makeDirectory(const std::string& path) {
+#ifdef _WIN32
+        _mkdir(path.c_str());
+#else
+        mkdir(path.c_str(), 0755);
+#endif
+    }
+}
+
+std::string ProgramCache::directory;
+uint64_t ProgramCache::driverHash = 0;
+bool ProgramCache::supported = false;
+bool ProgramCache::enabled = true;
+ProgramCacheStats ProgramCache::stats;
+
+void ProgramCache::init(const std::string& cacheDirectory) {
+    directory = cacheDirectory;
+
+    const bool core41 = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 1);
+    if (core41 || glfwExtensionSupported("GL_ARB_get_program_binary")) {
+        getProgramBinary = reinterpret_cast<GetProgramBinaryProc>(glfwGetProcAddress("glGetProgramBinary"));
+        programBinary = reinterpret_cast<ProgramBinaryProc>(glfwGetProcAddress("glProgramBinary"));
+        programParameteri = reinterpret_cast<ProgramParameteriProc>(glfwGetProcAddress("glProgramParameteri"));
+    }
+
+    // Alcuni driver espongono l'estensione senza alcun formato binario
+    GLint formats = 0;
+    if (getProgramBinary && programBinary && programParameteri)
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    supported = formats > 0;
+
+    driverHash = hashGLString(GL_VENDOR, 14695981039346656037ull);
+    driverHash = hashGLString(GL_RENDERER, driverHash);
+    driverHash = hashGLString(GL_VERSION, driverHash);
+
+    if (supported) makeDirectory(directory);
+    else std::cout << "ProgramCache: binari dei programmi non supportati, compilazione dai sorgenti\n";
+}
+
+uint64_t ProgramCache::makeKey(const std::string& vertexCode, const std::string& fragmentCode) {
+    uint64_t key = fnv1a64(vertexCode.data(), vertexCode.size(), driverHash);
+    key = fnv1a64("\0", 1, key);
+    return fnv1a64(fragmentCode.data(), fragmentCode.size(), key);
+}
+
+std::string ProgramCache::pathFor(uint64_t key) {
+    char name[24];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+    return directory + "/" + name + ".bin";
+}
+
+unsigned int ProgramCache::load(const std::string& vertexCode, const std::string& fragmentCode) {
+    if (!isActive()) return 0;
+
+    const uint64_t key = makeKey(vertexCode, fragmentCode);
+    std::ifstream file(pathFor(key), std::ios::binary);
+
+    CacheHeader header = {};
+    std::vector<char> binary;
+    bool valid = file.is_open()
+        && file.read(reinterpret_cast<char*>(&header), sizeof(header))
+        && header.magic == FILE_MAGIC && header.version == FILE_VERSION
+        && header.key == key && header.length > 0;
+    if (valid) {
+        binary.resize(header.length);
+        valid = static_cast<bool>(file.read(binary.data(), header.length));
+    }
+    if (!valid) {
+        stats.misses++;
+        return 0;
+    }
+
+    // Il driver può rifiutare un binario valido (es. dopo un aggiornamento): si ricompila
+    GLuint program = glCreateProgram();
+    programBinary(program, header.format, binary.data(), static_cast<GLsizei>(header.length));
+
+    GLint linked = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        glDeleteProgram(program);
+        stats.misses++;
+        return 0;
+    }
+
+    stats.hits++;
+    return program;
+}
+
+void ProgramCache::prepareForLink(unsigned int program) {
+    if (isActive()) programParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void ProgramCache::store(unsigned int program, const std::string& vertexCode, const std::string& fragmentCode) {
+    if (!isActive() || program == 0) return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<char> binary(static_cast<size_t>(length));
+    GLenum format = 0;
+    GLsizei written = 0;
+    getProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) return;
+
+    CacheHeader header = {};
+    header.magic = FILE_MAGIC;
+    header.version = FILE_VERSION;
+    header.key = makeKey(vertexCode, fragmentCode);
+    header.format = format;
+    header.length = static_cast<uint32_t>(written);
+
+    std::ofstream file(pathFor(header.key), std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "ERROR: ProgramCache: impossibile scrivere in " << directory << "\n";
+        return;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(binary.data(), written);
+    stats.stores++;
+}
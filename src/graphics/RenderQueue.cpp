@@ -0,0 +1,69 @@
+#include "graphics/RenderQueue.h"
+#include <algorithm>
+
+namespace {
+    constexpr uint64_t DEPTH_BITS = 10;
+    constexpr uint64_t SHADER_BITS = 11;
+    constexpr uint64_t MESH_BITS = 16;
+    constexpr uint64_t SEQUENCE_BITS = 24;
+
+    constexpr uint64_t MESH_SHIFT = SEQUENCE_BITS;
+    constexpr uint64_t SHADER_SHIFT = MESH_SHIFT + MESH_BITS;
+    constexpr uint64_t DEPTH_SHIFT = SHADER_SHIFT + SHADER_BITS;
+    constexpr uint64_t LAYER_SHIFT = DEPTH_SHIFT + DEPTH_BITS;
+    constexpr uint64_t TRANSLUCENT_SHIFT = LAYER_SHIFT + 2;
+    constexpr uint64_t LAYER_MAX = 3;
+
+    constexpr uint64_t mask(uint64_t bits) { return (uint64_t(1) << bits) - 1; }
+}
+
+uint64_t RenderQueue::makeKey(RenderLayer layer, bool translucent, float depth,
+    unsigned int shaderId, unsigned int meshId, uint32_t sequence) {
+    // Profondità [-1, 1] -> [0, 1023]: valori più alti sono più vicini alla camera
+    const float normalized = std::min(1.0f, std::max(0.0f, depth * 0.5f + 0.5f));
+    uint64_t depthBits = static_cast<uint64_t>(normalized * mask(DEPTH_BITS) + 0.5f);
+    uint64_t layerBits = static_cast<uint64_t>(layer);
+
+    uint64_t key = static_cast<uint64_t>(sequence) & mask(SEQUENCE_BITS);
+
+    if (translucent) {
+        // Dal più lontano al più vicino, come richiede il blending
+        key |= uint64_t(1) << TRANSLUCENT_SHIFT;
+    }
+    else {
+        // Dal più vicino al più lontano: i frammenti coperti falliscono il depth test
+        depthBits = mask(DEPTH_BITS) - depthBits;
+        layerBits = LAYER_MAX - layerBits;
+        key |= (static_cast<uint64_t>(shaderId) & mask(SHADER_BITS)) << SHADER_SHIFT;
+        key |= (static_cast<uint64_t>(meshId) & mask(MESH_BITS)) << MESH_SHIFT;
+    }
+    key |= (layerBits << LAYER_SHIFT) | (depthBits << DEPTH_SHIFT);
+    return key;
+}
+
+float RenderQueue::layerDepth(RenderLayer layer, float depth) {
+    const float offset = std::min(1.0f, std::max(-1.0f, depth)) * SUBMESH_DEPTH_SCALE;
+    return FIRST_BAND + static_cast<float>(layer) * LAYER_BAND + offset;
+}
+
+void RenderQueue::submit(RenderLayer layer, DrawPacket packet) {
+    const bool translucent = packet.color.w < 1.0f;
+    packet.depth = layerDepth(layer, packet.depth);
+    packet.sortKey = makeKey(layer, translucent, packet.depth, packet.shaderId, packet.meshId,
+        static_cast<uint32_t>(packets.size()));
+    packets.push_back(packet);
+}
+
+void RenderQueue::sort() {
+    std::sort(packets.begin(), packets.end(), [](const DrawPacket& a, const DrawPacket& b) {
+        return a.sortKey < b.sortKey;
+    });
+}
+
+size_t RenderQueue::getTranslucentBegin() const {
+    // Il bit dei trasparenti è il più significativo: dopo sort() formano un'unica coda finale
+    const auto first = std::partition_point(packets.begin(), packets.end(), [](const DrawPacket& packet) {
+        return (packet.sortKey >> TRANSLUCENT_SHIFT) == 0;
+    });
+    return static_cast<size_t>(first - packets.begin());
+}
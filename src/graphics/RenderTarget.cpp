@@ -0,0 +1,96 @@
+#include "graphics/RenderTarget.h"
+#include <iostream>
+
+RenderTarget::RenderTarget(bool withDepth)
+    : hasDepth(withDepth)
+{
+}
+
+RenderTarget::~RenderTarget() {
+    release();
+}
+
+void RenderTarget::release() {
+    if (depthBuffer) glDeleteRenderbuffers(1, &depthBuffer);
+    if (colorTexture) glDeleteTextures(1, &colorTexture);
+    if (framebuffer) glDeleteFramebuffers(1, &framebuffer);
+    depthBuffer = colorTexture = framebuffer = 0;
+    complete = false;
+}
+
+bool RenderTarget::resize(int newWidth, int newHeight) {
+    if (newWidth < 1) newWidth = 1;
+    if (newHeight < 1) newHeight = 1;
+    if (framebuffer && newWidth == width && newHeight == height) return false;
+
+    release();
+    width = newWidth;
+    height = newHeight;
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+    // Filtro lineare: il blit di ingrandimento interpola tra i texel
+    glGenTextures(1, &colorTexture);
+    glBindTexture(GL_TEXTURE_2D, colorTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+
+    if (hasDepth) {
+        glGenRenderbuffers(1, &depthBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    }
+
+    complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    if (!complete) {
+        std::cerr << "ERROR: Render target " << width << "x" << height << " incompleto\n";
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return true;
+}
+
+void RenderTarget::bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, width, height);
+}
+
+void RenderTarget::bindDefault(int viewportWidth, int viewportHeight) {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, viewportWidth, viewportHeight);
+}
+
+void RenderTarget::bindOrDefault(const RenderTarget* target, int screenWidth, int screenHeight) {
+    if (target) target->bind();
+    else bindDefault(screenWidth, screenHeight);
+}
+
+void RenderTarget::blitToScreen(int screenWidth, int screenHeight, GLenum filter) const {
+    blitTo(nullptr, screenWidth, screenHeight, filter);
+}
+
+void RenderTarget::blitTo(const RenderTarget* destination, int destWidth, int destHeight, GLenum filter) const {
+    if (!complete) return;
+
+    GLuint drawFramebuffer = 0;
+    if (destination) {
+        drawFramebuffer = destination->framebuffer;
+        destWidth = destination->width;
+        destHeight = destination->height;
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFramebuffer);
+    glBlitFramebuffer(0, 0, width, height, 0, 0, destWidth, destHeight, GL_COLOR_BUFFER_BIT, filter);
+
+    // La destinazione resta collegata per i disegni successivi
+    glBindFramebuffer(GL_FRAMEBUFFER, drawFramebuffer);
+}
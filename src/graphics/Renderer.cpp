@@ -1,156 +1,373 @@
-/**
- * @file Renderer.cpp
- * @brief Implementazione della classe Renderer, responsabile del disegno delle entit e delle mesh.
- */
-
-#include "graphics/Renderer.h"
-#include "graphics/MeshManager.h"
-#include "graphics/Shader.h"
-#include "graphics/Vertex.h"
-#include "graphics/Mesh.h"
-#include "game/SpaceCleaner.h"
-#include "graphics/ShaderManager.h"
-#include "game/GameObject.h"
-#include "game/Collision.h"
-#include "utilities/Timer.h"
-
- /**
-  * @brief Costruttore del Renderer. Inizializza la telecamera con matrici di identit e default.
-  */
-Renderer::Renderer() {
-    this->setCamera(glm::mat4(1.0f), glm::mat4(0.0f));
-}
-
-/**
- * @brief Aggiunge una mesh alla lista delle mesh gestite dal renderer.
- * @param mesh Puntatore condiviso alla mesh da aggiungere.
- */
-void Renderer::addMesh(const std::shared_ptr<Mesh>& mesh) {
-    meshes.push_back(mesh);
-}
-
-/**
- * @brief Imposta le matrici di vista e proiezione della telecamera.
- * @param viewMat Matrice di vista.
- * @param projMat Matrice di proiezione.
- */
-void Renderer::setCamera(const glm::mat4& viewMat, const glm::mat4& projMat) {
-    view = viewMat;
-    projection = projMat;
-}
-
-/**
- * @brief Disegna una singola mesh utilizzando uno shader specificato.
- * @param meshId ID della mesh da disegnare.
- * @param shaderId ID dello shader da utilizzare.
- * @param color Colore da applicare come uniform.
- * @param model Matrice modello (trasformazione dell'oggetto).
- * @param mode Modalit di disegno (es. GL_TRIANGLES, GL_LINES, ecc.).
- */
-void Renderer::drawMesh(const unsigned int meshId, const unsigned int shaderId, const glm::vec4& color, const glm::mat4& model, const GLenum mode)
-{
-    std::shared_ptr<Shader> shader = ShaderManager::get(shaderId);
-    if (!shader) return;
-
-    shader->bind();
-    shader->setUniformMat4("view", view);
-    shader->setUniformMat4("projection", projection);
-    shader->setUniformMat4("model", model);
-    shader->setUniformVec4("uColor", color);
-    shader->setUniform1f("uTime", static_cast<float>(Timer::totalTime));
-
-    auto mesh = MeshManager::getById(meshId);
-    if (mesh) {
-        mesh->draw(*shader, mode);
-    }
-
-    shader->unbind();
-}
-
-/**
- * @brief Pulisce lo schermo impostando il colore di sfondo e resettando i buffer di colore e profondit.
- */
-void Renderer::clear() {
-    glClearColor(0.05f, 0.05f, 0.1f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-}
-
-/**
- * @brief Disegna un'entit composta da pi submesh, ciascuna con shader e trasformazione propri.
- * @param entity Entit da disegnare.
- * @param mode Modalit di disegno (default GL_TRIANGLES).
- */
-void Renderer::drawEntityByInfo(Entity& entity, const GLenum mode) {
-    if (!entity.isActive() || !entity.renderData.enabled) return;
-
-    unsigned int currentShaderId = 0;
-    std::shared_ptr<Shader> activeShader = nullptr;
-
-    const glm::mat4 entityModel = entity.transform.getModelMatrix();
-
-    for (const auto& subMesh : entity.renderData.getSubMeshes()) {
-        if (subMesh.shaderId != currentShaderId && subMesh.visible) {
-            if (activeShader) activeShader->unbind();
-            activeShader = ShaderManager::get(subMesh.shaderId);
-
-            if (activeShader) {
-                activeShader->bind();
-                currentShaderId = subMesh.shaderId;
-                activeShader->setUniformMat4("view", view);
-                activeShader->setUniformMat4("projection", projection);
-            }
-        }
-
-        if (activeShader) {
-            glm::mat4 finalModel = entityModel * subMesh.localTransform;
-            activeShader->setUniformMat4("model", finalModel);
-            activeShader->setUniformVec4("uColor", subMesh.color);
-
-            auto mesh = MeshManager::getById(subMesh.meshId);
-            if (mesh) mesh->draw(*activeShader, mode);
-        }
-    }
-
-    if (activeShader) activeShader->unbind();
-}
-
-/**
- * @brief Disegna un riquadro (bounding box) 2D per il debug delle collisioni.
- * @param box Oggetto AABB contenente i punti minimo e massimo.
- * @param color Colore del contorno.
- * @param view Matrice di vista corrente.
- * @param projection Matrice di proiezione corrente.
- */
-void Renderer::drawBoundingBox(const AABB& box, const glm::vec4& color, const glm::mat4& view, const glm::mat4& projection)
-{
-    float vertices[] = {
-        box.min.x, box.min.y, 0.0f,
-        box.max.x, box.min.y, 0.0f,
-        box.max.x, box.max.y, 0.0f,
-        box.min.x, box.max.y, 0.0f
-    };
-
-    unsigned int VAO, VBO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-
-    auto shader = ShaderManager::get("DefaultShader");
-    if (shader) {
-        shader->bind();
-        shader->setUniformMat4("view", view);
-        shader->setUniformMat4("projection", projection);
-        shader->setUniformMat4("model", glm::mat4(1.0f));
-        shader->setUniformVec4("uColor", color);
-        glDrawArrays(GL_LINE_LOOP, 0, 4);
-        shader->unbind();
-    }
-
-    glDeleteBuffers(1, &VBO);
-    glDeleteVertexArrays(1, &VAO);
-}
+/**
+ * @file Renderer.cpp
+ * @brief Implementazione della classe Renderer, responsabile del disegno delle entità e delle mesh.
+ */
+
+#include "graphics/Renderer.h"
+#include "graphics/MeshManager.h"
+#include "graphics/Shader.h"
+#include "graphics/Vertex.h"
+#include "graphics/Mesh.h"
+#include "game/SpaceCleaner.h"
+#include "graphics/ShaderManager.h"
+#include "game/GameObject.h"
+#include "game/Collision.h"
+#include "graphics/GLStateCache.h"
+
+ /**
+  * @brief Costruttore del Renderer. Inizializza la telecamera con matrici di identità e default.
+  */
+Renderer::Renderer() {
+    this->setCamera(glm::mat4(1.0f), glm::mat4(0.0f));
+}
+
+Renderer::~Renderer() = default;
+
+/**
+ * @brief Salva i contatori del frame appena concluso e azzera quelli correnti
+ * (anche quelli di GLStateCache).
+ */
+void Renderer::beginFrame() {
+    lastFrameStats = stats;
+    stats = RenderStats();
+
+    // ImGui e il resto del frame precedente possono aver toccato lo stato OpenGL
+    GLStateCache::invalidate();
+    GLStateCache::beginFrame();
+}
+
+/**
+ * @brief Aggiunge una mesh alla lista delle mesh gestite dal renderer.
+ * @param mesh Puntatore condiviso alla mesh da aggiungere.
+ */
+void Renderer::addMesh(const std::shared_ptr<Mesh>& mesh) {
+    meshes.push_back(mesh);
+}
+
+/**
+ * @brief Imposta le matrici di vista e proiezione della telecamera.
+ * @param viewMat Matrice di vista.
+ * @param projMat Matrice di proiezione.
+ */
+void Renderer::setCamera(const glm::mat4& viewMat, const glm::mat4& projMat) {
+    view = viewMat;
+    projection = projMat;
+}
+
+/**
+ * @brief Carica camera, risoluzione e tempo nel blocco FrameData.
+ *
+ * L'UBO viene creato al primo uso (serve un contesto OpenGL) e resta collegato al
+ * binding point Shader::FRAME_DATA_BINDING: gli shader lo leggono senza upload per disegno.
+ * @param resolution Dimensione della finestra in pixel.
+ * @param time Tempo totale trascorso in secondi.
+ */
+void Renderer::updateFrameData(const glm::vec2& resolution, float time) {
+    if (!frameBuffer) {
+        const unsigned int binding = Shader::FRAME_DATA_BINDING;
+        frameBuffer = std::make_unique<vrtx::UniformBuffer>(
+            static_cast<unsigned int>(sizeof(FrameData)), binding);
+    }
+
+    FrameData data;
+    data.view = view;
+    data.projection = projection;
+    data.resolution = resolution;
+    data.time = time;
+    data.padding = 0.0f;
+    frameBuffer->update(&data, static_cast<unsigned int>(sizeof(FrameData)));
+}
+
+/**
+ * @brief Disegna una singola mesh utilizzando uno shader specificato.
+ * @param meshId ID della mesh da disegnare.
+ * @param shaderId ID dello shader da utilizzare.
+ * @param color Colore da applicare come uniform.
+ * @param model Trasformazione modello 2D (trasformazione dell'oggetto).
+ * @param mode Modalità di disegno (es. GL_TRIANGLES, GL_LINES, ecc.).
+ */
+void Renderer::drawMesh(const unsigned int meshId, const unsigned int shaderId, const glm::vec4& color, const Affine2D& model, const GLenum mode)
+{
+    std::shared_ptr<Shader> shader = ShaderManager::get(shaderId);
+    if (!shader) return;
+
+    shader->bind();
+
+    auto mesh = MeshManager::getById(meshId);
+    if (mesh) {
+        shader->setUniformMat4(uniforms::Model, (model * mesh->getDequantization()).toMat4());
+        shader->setUniformVec4(uniforms::Color, color);
+        mesh->draw(*shader, mode);
+        stats.drawCalls++;
+        stats.subMeshes++;
+    }
+
+    shader->unbind();
+}
+
+/**
+ * @brief Pulisce lo schermo impostando il colore di sfondo e resettando i buffer di colore e profondità.
+ */
+void Renderer::clear() {
+    glClearColor(0.05f, 0.05f, 0.1f, 1.0f);
+    GLStateCache::setDepthWrite(true); // Con la scrittura disabilitata glClear non toccherebbe la profondità
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+/**
+ * @brief Disegna un'entità composta da più submesh, ciascuna con shader e trasformazione propri.
+ * @param entity Entità da disegnare.
+ * @param mode Modalità di disegno (default GL_TRIANGLES).
+ */
+void Renderer::drawEntityByInfo(Entity& entity, const GLenum mode) {
+    if (!entity.isActive() || !entity.renderData.enabled) return;
+
+    unsigned int currentShaderId = 0;
+    std::shared_ptr<Shader> activeShader = nullptr;
+    UniformHandle modelUniform, colorUniform;
+
+    // Matrici mondo delle submesh (in cache nell'entità: ricalcolate solo se si è mossa)
+    const auto& worldMatrices = entity.getSubMeshWorldMatrices();
+    const auto& subMeshes = entity.renderData.getSubMeshes();
+
+    // Entità in movimento: si disegna lo stato interpolato tra gli ultimi due passi di simulazione
+    const bool interpolate = interpolationAlpha < 1.0f && entity.transform.hasMoved();
+    const Affine2D interpolatedModel = interpolate
+        ? entity.transform.getInterpolatedMatrix(interpolationAlpha)
+        : Affine2D();
+
+    for (size_t i = 0; i < subMeshes.size(); ++i) {
+        const auto& subMesh = subMeshes[i];
+        if (subMesh.shaderId != currentShaderId && subMesh.visible) {
+            if (activeShader) activeShader->unbind();
+            activeShader = ShaderManager::get(subMesh.shaderId);
+
+            if (activeShader) {
+                activeShader->bind();
+                currentShaderId = subMesh.shaderId;
+                modelUniform = activeShader->getUniformHandle(uniforms::Model);
+                colorUniform = activeShader->getUniformHandle(uniforms::Color);
+            }
+        }
+
+        if (activeShader) {
+            const Affine2D world = interpolate ? interpolatedModel * subMesh.localTransform : worldMatrices[i];
+
+            auto mesh = MeshManager::getById(subMesh.meshId);
+            if (mesh) {
+                activeShader->setUniformMat4(modelUniform, (world * mesh->getDequantization()).toMat4(subMesh.depth));
+                activeShader->setUniformVec4(colorUniform, subMesh.color);
+                mesh->draw(*activeShader, mode);
+                stats.drawCalls++;
+                stats.subMeshes++;
+            }
+        }
+    }
+
+    if (activeShader) activeShader->unbind();
+}
+
+/**
+ * @brief Associa a uno shader la sua variante instanced.
+ */
+void Renderer::setInstancedShader(unsigned int baseShaderId, unsigned int instancedShaderId) {
+    instancedShaders[baseShaderId] = instancedShaderId;
+}
+
+/**
+ * @brief Trasforma ogni sub-mesh visibile in un pacchetto della coda.
+ *
+ * La trasformazione è la stessa di drawEntityByInfo (matrice in cache o stato interpolato).
+ */
+void Renderer::submitEntity(Entity& entity, RenderLayer layer, const GLenum mode) {
+    if (!entity.isActive() || !entity.renderData.enabled) return;
+
+    const auto& subMeshes = entity.renderData.getSubMeshes();
+    const auto& worldMatrices = entity.getSubMeshWorldMatrices();
+    const bool interpolate = interpolationAlpha < 1.0f && entity.transform.hasMoved();
+    const Affine2D interpolatedModel = interpolate
+        ? entity.transform.getInterpolatedMatrix(interpolationAlpha)
+        : Affine2D();
+
+    for (size_t i = 0; i < subMeshes.size(); ++i) {
+        const auto& subMesh = subMeshes[i];
+        if (!subMesh.visible) continue;
+
+        DrawPacket packet;
+        packet.meshId = subMesh.meshId;
+        packet.shaderId = subMesh.shaderId;
+        packet.mode = mode;
+        packet.model = interpolate ? interpolatedModel * subMesh.localTransform : worldMatrices[i];
+        packet.depth = subMesh.depth;
+        packet.color = subMesh.color;
+        queue.submit(layer, packet);
+    }
+}
+
+void Renderer::submitMesh(unsigned int meshId, unsigned int shaderId, const glm::vec4& color,
+    const Affine2D& model, RenderLayer layer, const GLenum mode) {
+    DrawPacket packet;
+    packet.meshId = meshId;
+    packet.shaderId = shaderId;
+    packet.mode = mode;
+    packet.model = model;
+    packet.color = color;
+    queue.submit(layer, packet);
+}
+
+void Renderer::submitBoundingBox(const AABB& box, const glm::vec4& color) {
+    debugDraw.box(box, color);
+}
+
+/**
+ * @brief Esegue i pacchetti [first, last) della coda ordinata, un gruppo (stessa mesh,
+ * shader e primitiva) alla volta.
+ *
+ * Programma e mesh collegati vengono ricordati tra un gruppo e l'altro; camera e tempo
+ * arrivano dal blocco FrameData, quindi per pacchetto si caricano solo `model` e `uColor`
+ * (e nemmeno quelli nei gruppi instanced).
+ */
+void Renderer::drawPackets(size_t first, size_t last) {
+    const std::vector<DrawPacket>& packets = queue.getPackets();
+
+    if (!instanceBuffer) {
+        instanceBuffer = std::make_unique<vrtx::VertexBuffer>(
+            static_cast<unsigned int>(256 * sizeof(InstanceData)));
+    }
+
+    vrtx::VertexBufferLayout instanceLayout;
+    instanceLayout.push<float>(4); // linear
+    instanceLayout.push<float>(4); // translation
+    instanceLayout.push<float>(4); // color
+
+    std::shared_ptr<Shader> boundShader;
+    int boundFormat = -1; ///< Formato dei vertici del VAO dell'arena collegato (-1 nessuno)
+
+    size_t i = first;
+    while (i < last) {
+        const DrawPacket& head = packets[i];
+
+        // Gruppo: pacchetti adiacenti con la stessa mesh, lo stesso shader e la stessa primitiva
+        size_t end = i + 1;
+        while (end < last
+            && packets[end].meshId == head.meshId
+            && packets[end].shaderId == head.shaderId
+            && packets[end].mode == head.mode) {
+            ++end;
+        }
+        const unsigned int count = static_cast<unsigned int>(end - i);
+        stats.packets += count;
+
+        auto variant = instancedShaders.find(head.shaderId);
+        const bool instanced = count > 1 && variant != instancedShaders.end();
+        std::shared_ptr<Shader> shader = ShaderManager::get(instanced ? variant->second : head.shaderId);
+        std::shared_ptr<Mesh> mesh = MeshManager::getById(head.meshId);
+        if (!shader || !mesh) {
+            i = end;
+            continue;
+        }
+
+        const int format = static_cast<int>(mesh->getRange().format);
+
+        // Il buffer delle istanze viene collegato una sola volta al VAO condiviso (lasciandolo collegato)
+        if (instanced && mesh->attachInstanceBuffer(*instanceBuffer, instanceLayout))
+            boundFormat = format;
+
+        if (shader != boundShader) {
+            shader->bind();
+            boundShader = shader;
+            stats.programBinds++;
+            stats.programBindsSkipped += count - 1;
+        }
+        else {
+            stats.programBindsSkipped += count;
+        }
+
+        // Tutte le mesh stanno nella GeometryArena: il VAO cambia solo con il formato dei vertici
+        if (format != boundFormat) {
+            mesh->bind();
+            boundFormat = format;
+            stats.vaoBinds++;
+            stats.vaoBindsSkipped += count - 1;
+        }
+        else {
+            stats.vaoBindsSkipped += count;
+        }
+
+        // Posizioni a 16 bit: la model include il ritorno allo spazio locale della mesh
+        const bool quantized = mesh->isQuantized();
+        const Affine2D& dequantization = mesh->getDequantization();
+
+        if (instanced) {
+            instanceScratch.clear();
+            for (size_t k = i; k < end; ++k) {
+                const Affine2D world = quantized ? packets[k].model * dequantization : packets[k].model;
+                InstanceData instance;
+                instance.linear = glm::vec4(world.x.x, world.x.y, world.y.x, world.y.y);
+                instance.translation = glm::vec4(world.t, packets[k].depth, 1.0f);
+                instance.color = packets[k].color;
+                instanceScratch.push_back(instance);
+            }
+            instanceBuffer->update(instanceScratch.data(), count * static_cast<unsigned int>(sizeof(InstanceData)));
+            instanceBuffer->unbind();
+            mesh->drawElementsInstanced(head.mode, count);
+
+            stats.drawCalls++;
+            stats.instancedDrawCalls++;
+            stats.instances += count;
+        }
+        else {
+            // Nomi risolti una volta per gruppo: per pacchetto solo accessi per indice
+            const UniformHandle modelUniform = shader->getUniformHandle(uniforms::Model);
+            const UniformHandle colorUniform = shader->getUniformHandle(uniforms::Color);
+            for (size_t k = i; k < end; ++k) {
+                const Affine2D world = quantized ? packets[k].model * dequantization : packets[k].model;
+                shader->setUniformMat4(modelUniform, world.toMat4(packets[k].depth));
+                shader->setUniformVec4(colorUniform, packets[k].color);
+                mesh->drawElements(head.mode);
+                stats.drawCalls++;
+            }
+        }
+        stats.subMeshes += count;
+        i = end;
+    }
+}
+
+/**
+ * @brief Prima passata: ordina la coda e disegna gli opachi dal più vicino al più lontano,
+ * con depth test e scrittura della profondità. Il blending non serve (alpha = 1).
+ */
+void Renderer::flushOpaque() {
+    queue.sort();
+    translucentBegin = queue.getTranslucentBegin();
+
+    GLStateCache::setDepthTest(true);
+    GLStateCache::setDepthWrite(true);
+    GLStateCache::setBlend(false);
+    drawPackets(0, translucentBegin);
+}
+
+/**
+ * @brief Seconda passata: i trasparenti dal più lontano al più vicino, con depth test ma
+ * senza scrittura (non si coprono a vicenda), poi le primitive di debug sopra a tutto.
+ * Lascia il depth test disabilitato per ImGui e i blit dei render target.
+ */
+void Renderer::flushTranslucent() {
+    GLStateCache::setDepthTest(true);
+    GLStateCache::setDepthWrite(false);
+    GLStateCache::setBlend(true);
+    drawPackets(translucentBegin, queue.size());
+
+    queue.clear();
+    translucentBegin = 0;
+
+    // Primitive di debug: un solo upload e una sola chiamata per tutte
+    GLStateCache::setDepthTest(false);
+    stats.drawCalls += debugDraw.flush();
+    stats.debugLines += debugDraw.getLastLineCount();
+}
+
+void Renderer::flush() {
+    flushOpaque();
+    flushTranslucent();
+}
@@ -1,121 +1,310 @@
-/**
- * @file Shader.cpp
- * @brief Implementazione della classe Shader.
- */
-
-#include "graphics/Shader.h"
-#include <vector>
-#include <glm/gtc/type_ptr.hpp>
-#include "utilities/Utilities.h"
-
- /**
-  * @brief Costruttore: compila e linka un programma shader dai codici sorgente.
-  * @param vertexShader Codice sorgente dello shader vertex.
-  * @param fragmentShader Codice sorgente dello shader fragment.
-  */
-Shader::Shader(const std::string& vertexShader, const std::string& fragmentShader) {
-    rendererId = createShader(vertexShader, fragmentShader);
-}
-
-/** @brief Distruttore: rimuove il programma shader da OpenGL. */
-Shader::~Shader() {
-    glDeleteProgram(rendererId);
-}
-
-void Shader::setUniform4f(const std::string& name, float v0, float v1, float v2, float v3) {
-    glUniform4f(getUniformLocationCached(name), v0, v1, v2, v3);
-}
-
-void Shader::setUniformVec4(const std::string& name, const glm::vec4& vec) {
-    glUniform4fv(getUniformLocationCached(name), 1, glm::value_ptr(vec));
-}
-
-void Shader::setUniformMat4(const std::string& name, const glm::mat4& matrix) {
-    glUniformMatrix4fv(getUniformLocationCached(name), 1, GL_FALSE, glm::value_ptr(matrix));
-}
-
-void Shader::setUniform1f(const std::string& name, float value) {
-    glUniform1f(getUniformLocationCached(name), value);
-}
-
-void Shader::setUniformVec2(const std::string& name, const glm::vec2& vec) {
-    glUniform2fv(getUniformLocationCached(name), 1, glm::value_ptr(vec));
-}
-
-/**
- * @brief Compila uno shader e segnala eventuali errori di compilazione.
- * @param shader ID OpenGL dello shader da compilare.
- * @param type Tipo dello shader (VERTEX o FRAGMENT).
- * @return true se la compilazione ha avuto successo, false altrimenti.
- */
-bool Shader::compileShader(unsigned int shader, const std::string& type) {
-    int success;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-
-    if (!success) {
-        int length;
-        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
-        std::vector<char> infoLog(length);
-        glGetShaderInfoLog(shader, length, &length, infoLog.data());
-        std::cerr << "ERROR: Shader compilation failed (" << type << ")\n" << infoLog.data() << "\n";
-        return false;
-    }
-    return true;
-}
-
-/**
- * @brief Crea, compila e linka un programma shader completo.
- * @param vertexCode Codice sorgente dello shader vertex.
- * @param fragmentCode Codice sorgente dello shader fragment.
- * @return LID del programma shader creato.
- */
-unsigned int Shader::createShader(const std::string& vertexCode, const std::string& fragmentCode) {
-    const char* vCode = vertexCode.c_str();
-    const char* fCode = fragmentCode.c_str();
-
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vCode, nullptr);
-    glCompileShader(vertexShader);
-    if (!compileShader(vertexShader, "VERTEX")) return 0;
-
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fCode, nullptr);
-    glCompileShader(fragmentShader);
-    if (!compileShader(fragmentShader, "FRAGMENT")) return 0;
-
-    unsigned int program = glCreateProgram();
-    glAttachShader(program, vertexShader);
-    glAttachShader(program, fragmentShader);
-    glLinkProgram(program);
-
-    int success;
-    glGetProgramiv(program, GL_LINK_STATUS, &success);
-    if (!success) {
-        int length;
-        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
-        std::vector<char> infoLog(length);
-        glGetProgramInfoLog(program, length, &length, infoLog.data());
-        std::cerr << "ERROR: Shader linking failed\n" << infoLog.data() << "\n";
-    }
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-    return program;
-}
-
-void Shader::bind() const { glUseProgram(rendererId); }
-void Shader::unbind() { glUseProgram(0); }
-
-/**
- * @brief Restituisce la location di una uniform, usando la cache per ottimizzare le chiamate OpenGL.
- * @param name Nome della variabile uniform.
- * @return Location della uniform.
- */
-int Shader::getUniformLocationCached(const std::string& name) const {
-    auto it = uniformLocationCache.find(name);
-    if (it != uniformLocationCache.end()) return it->second;
-
-    int location = glGetUniformLocation(rendererId, name.c_str());
-    uniformLocationCache[name] = location;
-    return location;
-}
+/**
+ * @file Shader.cpp
+ * @brief Implementazione della classe Shader.
+ */
+
+#include "graphics/Shader.h"
+#include <vector>
+#include <cstring>
+#include <glm/gtc/type_ptr.hpp>
+#include <GLFW/glfw3.h>
+#include "graphics/GLStateCache.h"
+#include "graphics/ProgramCache.h"
+#include "utilities/Utilities.h"
+
+// GL_KHR_parallel_shader_compile: assente dal loader GLAD 3.3 del progetto
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+bool Shader::parallelCompile = false;
+
+ /**
+  * @brief Costruttore: compila e linka un programma shader dai codici sorgente.
+  * @param vertexShader Codice sorgente dello shader vertex.
+  * @param fragmentShader Codice sorgente dello shader fragment.
+  * @param deferred Se vero l'esito non viene letto subito: va chiamato finishBuild()
+  */
+Shader::Shader(const std::string& vertexShader, const std::string& fragmentShader, bool deferred) {
+    startBuild(vertexShader, fragmentShader);
+    if (!deferred) finishBuild();
+}
+
+/** @brief Distruttore: rimuove il programma shader da OpenGL. */
+Shader::~Shader() {
+    if (building) {
+        glDeleteShader(vertexShaderId);
+        glDeleteShader(fragmentShaderId);
+    }
+    GLStateCache::onProgramDeleted(rendererId);
+    glDeleteProgram(rendererId);
+}
+
+UniformHandle Shader::getUniformHandle(const UniformName& name) const {
+    UniformHandle handle;
+    auto it = uniformIndex.find(name.hash);
+    if (it != uniformIndex.end()) handle.index = it->second;
+    return handle;
+}
+
+void Shader::setUniformVec4(UniformHandle handle, const glm::vec4& vec) {
+    if (!handle.isValid()) return;
+    UniformSlot& slot = uniformSlots[handle.index];
+    if (updateShadow(slot, glm::value_ptr(vec), 4))
+        glUniform4fv(slot.location, 1, glm::value_ptr(vec));
+}
+
+void Shader::setUniformMat4(UniformHandle handle, const glm::mat4& matrix) {
+    if (!handle.isValid()) return;
+    UniformSlot& slot = uniformSlots[handle.index];
+    if (updateShadow(slot, glm::value_ptr(matrix), 16))
+        glUniformMatrix4fv(slot.location, 1, GL_FALSE, glm::value_ptr(matrix));
+}
+
+void Shader::setUniform1f(UniformHandle handle, float value) {
+    if (!handle.isValid()) return;
+    UniformSlot& slot = uniformSlots[handle.index];
+    if (updateShadow(slot, &value, 1))
+        glUniform1f(slot.location, value);
+}
+
+void Shader::setUniformVec2(UniformHandle handle, const glm::vec2& vec) {
+    if (!handle.isValid()) return;
+    UniformSlot& slot = uniformSlots[handle.index];
+    if (updateShadow(slot, glm::value_ptr(vec), 2))
+        glUniform2fv(slot.location, 1, glm::value_ptr(vec));
+}
+
+void Shader::setUniform4f(const UniformName& name, float v0, float v1, float v2, float v3) {
+    setUniformVec4(getUniformHandle(name), glm::vec4(v0, v1, v2, v3));
+}
+
+void Shader::setUniformVec4(const UniformName& name, const glm::vec4& vec) {
+    setUniformVec4(getUniformHandle(name), vec);
+}
+
+void Shader::setUniformMat4(const UniformName& name, const glm::mat4& matrix) {
+    setUniformMat4(getUniformHandle(name), matrix);
+}
+
+void Shader::setUniform1f(const UniformName& name, float value) {
+    setUniform1f(getUniformHandle(name), value);
+}
+
+void Shader::setUniformVec2(const UniformName& name, const glm::vec2& vec) {
+    setUniformVec2(getUniformHandle(name), vec);
+}
+
+/**
+ * @brief Aggiorna la copia del valore; le uniform inesistenti (location -1) non vengono mai caricate.
+ */
+bool Shader::updateShadow(UniformSlot& slot, const float* data, int size) {
+    if (slot.location < 0) return false;
+
+    const bool changed = slot.size != size || std::memcmp(slot.value, data, size * sizeof(float)) != 0;
+    if (changed) {
+        std::memcpy(slot.value, data, size * sizeof(float));
+        slot.size = size;
+    }
+    GLStateCache::countUniform(changed);
+    return changed;
+}
+
+/**
+ * @brief Legge l'esito della compilazione di uno shader e ne stampa il log in caso di errore.
+ * @param shader ID OpenGL dello shader compilato.
+ * @param type Tipo dello shader (VERTEX o FRAGMENT).
+ * @return true se la compilazione ha avuto successo, false altrimenti.
+ */
+bool Shader::checkCompileStatus(unsigned int shader, const std::string& type) {
+    int success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+
+    if (!success) {
+        int length;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> infoLog(length);
+        glGetShaderInfoLog(shader, length, &length, infoLog.data());
+        std::cerr << "ERROR: Shader compilation failed (" << type << ")\n" << infoLog.data() << "\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Avvia la costruzione del programma senza interrogarne lo stato.
+ *
+ * Se ProgramCache ha il binario di questi sorgenti per il driver corrente, il programma
+ * viene creato da quello ed è subito pronto. Altrimenti compilazione e link vengono solo
+ * accodati: il driver può eseguirli in parallelo (KHR_parallel_shader_compile) finché
+ * finishBuild() non ne legge l'esito.
+ * @param vertexCode Codice sorgente dello shader vertex.
+ * @param fragmentCode Codice sorgente dello shader fragment.
+ */
+void Shader::startBuild(const std::string& vertexCode, const std::string& fragmentCode) {
+    unsigned int cached = ProgramCache::load(vertexCode, fragmentCode);
+    if (cached != 0) {
+        // I binding dei blocchi uniform non fanno parte del binario: vanno reimpostati
+        rendererId = cached;
+        bindFrameDataBlock(rendererId);
+        registerUniforms();
+        return;
+    }
+
+    const char* vCode = vertexCode.c_str();
+    const char* fCode = fragmentCode.c_str();
+
+    vertexShaderId = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertexShaderId, 1, &vCode, nullptr);
+    glCompileShader(vertexShaderId);
+
+    fragmentShaderId = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragmentShaderId, 1, &fCode, nullptr);
+    glCompileShader(fragmentShaderId);
+
+    // Il link può essere richiesto subito: se la compilazione fallisce fallirà anche lui
+    rendererId = glCreateProgram();
+    glAttachShader(rendererId, vertexShaderId);
+    glAttachShader(rendererId, fragmentShaderId);
+    ProgramCache::prepareForLink(rendererId);
+    glLinkProgram(rendererId);
+
+    // I sorgenti servono solo come chiave per salvare il binario a link concluso
+    if (ProgramCache::isActive()) {
+        pendingVertexCode = vertexCode;
+        pendingFragmentCode = fragmentCode;
+    }
+    building = true;
+}
+
+/**
+ * @brief Vero se il driver ha finito compilazione e link (interrogarlo ora non blocca).
+ * Senza KHR_parallel_shader_compile non si può sapere: vale sempre true.
+ */
+bool Shader::isBuildComplete() const {
+    if (!building || !parallelCompile) return true;
+
+    GLint complete = GL_FALSE;
+    glGetProgramiv(rendererId, GL_COMPLETION_STATUS_KHR, &complete);
+    return complete == GL_TRUE;
+}
+
+/**
+ * @brief Legge l'esito di compilazione e link, poi completa il programma (cache, FrameData, uniform).
+ * Se qualcosa è fallito il programma viene eliminato e lo shader resta non valido.
+ */
+void Shader::finishBuild() {
+    if (!building) return;
+    building = false;
+
+    bool success = checkCompileStatus(vertexShaderId, "VERTEX");
+    success = checkCompileStatus(fragmentShaderId, "FRAGMENT") && success;
+
+    if (success) {
+        int linked;
+        glGetProgramiv(rendererId, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            int length;
+            glGetProgramiv(rendererId, GL_INFO_LOG_LENGTH, &length);
+            std::vector<char> infoLog(length);
+            glGetProgramInfoLog(rendererId, length, &length, infoLog.data());
+            std::cerr << "ERROR: Shader linking failed\n" << infoLog.data() << "\n";
+            success = false;
+        }
+    }
+
+    glDetachShader(rendererId, vertexShaderId);
+    glDetachShader(rendererId, fragmentShaderId);
+    glDeleteShader(vertexShaderId);
+    glDeleteShader(fragmentShaderId);
+    vertexShaderId = fragmentShaderId = 0;
+
+    if (!success) {
+        GLStateCache::onProgramDeleted(rendererId);
+        glDeleteProgram(rendererId);
+        rendererId = 0;
+    }
+    else {
+        ProgramCache::store(rendererId, pendingVertexCode, pendingFragmentCode);
+        bindFrameDataBlock(rendererId);
+        registerUniforms();
+    }
+
+    pendingVertexCode.clear();
+    pendingFragmentCode.clear();
+}
+
+/**
+ * @brief Chiede al driver di compilare in parallelo (GL_KHR/ARB_parallel_shader_compile).
+ *
+ * Il loader GLAD 3.3 del progetto non conosce l'estensione: la funzione viene risolta con
+ * glfwGetProcAddress. Senza estensione la compilazione resta comunque differita, ma il
+ * primo controllo di stato in finishBuild() attende il driver.
+ */
+bool Shader::enableParallelCompile() {
+    typedef void (APIENTRYP MaxShaderCompilerThreadsProc)(GLuint count);
+
+    MaxShaderCompilerThreadsProc maxThreads = nullptr;
+    if (glfwExtensionSupported("GL_KHR_parallel_shader_compile"))
+        maxThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(glfwGetProcAddress("glMaxShaderCompilerThreadsKHR"));
+    else if (glfwExtensionSupported("GL_ARB_parallel_shader_compile"))
+        maxThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(glfwGetProcAddress("glMaxShaderCompilerThreadsARB"));
+
+    parallelCompile = maxThreads != nullptr;
+    if (parallelCompile) maxThreads(0xFFFFFFFFu); // Numero di thread scelto dal driver
+    return parallelCompile;
+}
+
+/**
+ * @brief Il GLSL 3.30 non ammette layout(binding = N): il blocco dei dati del frame
+ * viene collegato al suo binding point qui, se lo shader lo dichiara.
+ */
+void Shader::bindFrameDataBlock(unsigned int program) {
+    unsigned int frameBlock = glGetUniformBlockIndex(program, FRAME_DATA_BLOCK);
+    if (frameBlock != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, frameBlock, FRAME_DATA_BINDING);
+    }
+}
+
+void Shader::bind() const { GLStateCache::useProgram(rendererId); }
+void Shader::unbind() { GLStateCache::useProgram(0); }
+
+/**
+ * @brief Registra le uniform attive del programma: uno slot per ciascuna, indicizzato per hash del nome.
+ *
+ * I membri dei blocchi uniform (es. FrameData) non hanno location e vengono ignorati.
+ * Per gli array il nome riportato dal driver termina con "[0]": il suffisso viene tolto,
+ * così la uniform si risolve con il nome usato nel sorgente.
+ */
+void Shader::registerUniforms() {
+    int count = 0;
+    int maxLength = 0;
+    glGetProgramiv(rendererId, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(rendererId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::vector<char> buffer(static_cast<size_t>(maxLength) + 1);
+    for (int i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint arraySize = 0;
+        GLenum type = 0;
+        glGetActiveUniform(rendererId, static_cast<GLuint>(i), maxLength, &length, &arraySize, &type, buffer.data());
+
+        const int location = glGetUniformLocation(rendererId, buffer.data());
+        if (location < 0) continue;
+
+        std::string name(buffer.data(), length);
+        const size_t bracket = name.find('[');
+        if (bracket != std::string::npos) name.erase(bracket);
+
+        const uint32_t hash = UniformName::fnv1a(name.c_str());
+        if (uniformIndex.count(hash)) {
+            std::cerr << "ERROR: Uniform hash collision on '" << name << "'\n";
+            continue;
+        }
+
+        UniformSlot slot;
+        slot.location = location;
+        uniformIndex[hash] = static_cast<int>(uniformSlots.size());
+        uniformSlots.push_back(slot);
+    }
+}
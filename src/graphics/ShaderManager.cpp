@@ -1,57 +1,94 @@
-/**
- * @file ShaderManager.cpp
- * @brief Implementazione del gestore centralizzato degli shader.
- */
-
-#include "graphics/ShaderManager.h"
-#include "graphics/Shader.h"
-#include <stdexcept>
-
-std::unordered_map<std::string, std::shared_ptr<Shader>> ShaderManager::shadersMap;
-std::unordered_map<unsigned int, std::shared_ptr<Shader>> ShaderManager::idShadersMap;
-std::unordered_map<std::string, unsigned int> ShaderManager::nameToIdMap;
-unsigned int ShaderManager::nextId = 1;
-
-/**
- * @brief Carica e registra un nuovo shader se non esiste gi.
- */
-unsigned int ShaderManager::load(const std::string& name, const std::string& vertexPath, const std::string& fragmentPath)
-{
-    auto it = nameToIdMap.find(name);
-    if (it != nameToIdMap.end()) return it->second;
-
-    auto shader = std::make_shared<Shader>(vertexPath, fragmentPath);
-    unsigned int newId = nextId++;
-    shadersMap[name] = shader;
-    idShadersMap[newId] = shader;
-    nameToIdMap[name] = newId;
-
-    return newId;
-}
-
-/**
- * @brief Recupera uno shader tramite nome.
- */
-std::shared_ptr<Shader> ShaderManager::get(const std::string& name)
-{
-    auto it = shadersMap.find(name);
-    return it != shadersMap.end() ? it->second : nullptr;
-}
-
-/**
- * @brief Recupera uno shader tramite ID.
- */
-std::shared_ptr<Shader> ShaderManager::get(unsigned int id)
-{
-    auto it = idShadersMap.find(id);
-    return it != idShadersMap.end() ? it->second : nullptr;
-}
-
-/**
- * @brief Restituisce lID associato al nome dello shader.
- */
-unsigned int ShaderManager::getId(const std::string& name)
-{
-    auto it = nameToIdMap.find(name);
-    return it != nameToIdMap.end() ? it->second : 0;
-}
+/**
+ * @file ShaderManager.cpp
+ * @brief Implementazione del gestore centralizzato degli shader.
+ */
+
+#include "graphics/ShaderManager.h"
+#include "graphics/Shader.h"
+#include <stdexcept>
+#include <thread>
+
+std::unordered_map<std::string, std::shared_ptr<Shader>> ShaderManager::shadersMap;
+std::unordered_map<unsigned int, std::shared_ptr<Shader>> ShaderManager::idShadersMap;
+std::unordered_map<std::string, unsigned int> ShaderManager::nameToIdMap;
+unsigned int ShaderManager::nextId = 1;
+bool ShaderManager::deferBuilds = false;
+std::vector<std::shared_ptr<Shader>> ShaderManager::pendingBuilds;
+
+/**
+ * @brief Carica e registra un nuovo shader se non esiste già.
+ */
+unsigned int ShaderManager::load(const std::string& name, const std::string& vertexPath, const std::string& fragmentPath)
+{
+    auto it = nameToIdMap.find(name);
+    if (it != nameToIdMap.end()) return it->second;
+
+    auto shader = std::make_shared<Shader>(vertexPath, fragmentPath, deferBuilds);
+    if (shader->isBuilding()) pendingBuilds.push_back(shader);
+    unsigned int newId = nextId++;
+    shadersMap[name] = shader;
+    idShadersMap[newId] = shader;
+    nameToIdMap[name] = newId;
+
+    return newId;
+}
+
+void ShaderManager::beginDeferredBuilds() {
+    deferBuilds = true;
+}
+
+/**
+ * @brief Completa gli shader in sospeso.
+ *
+ * Con la compilazione parallela si completano per primi quelli che il driver ha già finito,
+ * cedendo il thread quando nessuno è pronto; senza, isBuildComplete() è sempre vero e
+ * finishBuild() attende il driver uno shader alla volta.
+ */
+unsigned int ShaderManager::finishDeferredBuilds() {
+    deferBuilds = false;
+    const unsigned int total = static_cast<unsigned int>(pendingBuilds.size());
+
+    while (!pendingBuilds.empty()) {
+        bool progressed = false;
+        for (size_t i = 0; i < pendingBuilds.size();) {
+            if (pendingBuilds[i]->isBuildComplete()) {
+                pendingBuilds[i]->finishBuild();
+                pendingBuilds[i] = pendingBuilds.back();
+                pendingBuilds.pop_back();
+                progressed = true;
+            }
+            else {
+                ++i;
+            }
+        }
+        if (!progressed) std::this_thread::yield();
+    }
+    return total;
+}
+
+/**
+ * @brief Recupera uno shader tramite nome.
+ */
+std::shared_ptr<Shader> ShaderManager::get(const std::string& name)
+{
+    auto it = shadersMap.find(name);
+    return it != shadersMap.end() ? it->second : nullptr;
+}
+
+/**
+ * @brief Recupera uno shader tramite ID.
+ */
+std::shared_ptr<Shader> ShaderManager::get(unsigned int id)
+{
+    auto it = idShadersMap.find(id);
+    return it != idShadersMap.end() ? it->second : nullptr;
+}
+
+/**
+ * @brief Restituisce l’ID associato al nome dello shader.
+ */
+unsigned int ShaderManager::getId(const std::string& name)
+{
+    auto it = nameToIdMap.find(name);
+    return it != nameToIdMap.end() ? it->second : 0;
+}
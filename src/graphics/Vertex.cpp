@@ -1,131 +1,192 @@
-/**
- * @file Vertex.cpp
- * @brief Implementazione delle classi per la gestione dei buffer di vertici e indici.
- */
-
-#include "graphics/Vertex.h"
-
-namespace vrtx {
-
-    // ======================== Vertex ========================
-
-    Vertex::Vertex(const glm::vec2& pos, const glm::vec3& col)
-        : position(pos), color(col) {
-    }
-
-    // =================== VertexBufferElement ===================
-
-    VertexBufferElement::VertexBufferElement(unsigned int type, unsigned int count, bool normalized)
-        : type(type), count(count), normalized(normalized) {
-    }
-
-    unsigned int VertexBufferElement::getSizeOfType(unsigned int type) {
-        switch (type) {
-        case GL_FLOAT:         return sizeof(GLfloat);
-        case GL_UNSIGNED_INT:  return sizeof(GLuint);
-        case GL_UNSIGNED_BYTE: return sizeof(GLubyte);
-        default:               return 0;
-        }
-    }
-
-    // =================== VertexBufferLayout ===================
-
-    template<> void VertexBufferLayout::push<float>(int count) {
-        elements.emplace_back(GL_FLOAT, count, GL_FALSE);
-        stride += count * VertexBufferElement::getSizeOfType(GL_FLOAT);
-    }
-
-    template<> void VertexBufferLayout::push<unsigned int>(int count) {
-        elements.emplace_back(GL_UNSIGNED_INT, count, GL_FALSE);
-        stride += count * VertexBufferElement::getSizeOfType(GL_UNSIGNED_INT);
-    }
-
-    template<> void VertexBufferLayout::push<unsigned char>(int count) {
-        elements.emplace_back(GL_UNSIGNED_BYTE, count, GL_FALSE);
-        stride += count * VertexBufferElement::getSizeOfType(GL_UNSIGNED_BYTE);
-    }
-
-    unsigned int VertexBufferLayout::getStride() const { return stride; }
-    const std::vector<VertexBufferElement>& VertexBufferLayout::getElements() const { return elements; }
-
-    // ======================== VertexBuffer ========================
-
-    VertexBuffer::VertexBuffer(const void* data, unsigned int size) {
-        glGenBuffers(1, &rendererId);
-        bind();
-        glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
-    }
-
-    VertexBuffer::~VertexBuffer() {
-        glDeleteBuffers(1, &rendererId);
-    }
-
-    void VertexBuffer::bind() const {
-        glBindBuffer(GL_ARRAY_BUFFER, rendererId);
-    }
-
-    void VertexBuffer::unbind() const {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-    }
-
-    // ======================== VertexArray ========================
-
-    VertexArray::VertexArray() {
-        glGenVertexArrays(1, &id);
-    }
-
-    VertexArray::~VertexArray() {
-        glDeleteVertexArrays(1, &id);
-    }
-
-    void VertexArray::bind() const {
-        glBindVertexArray(id);
-    }
-
-    void VertexArray::unbind() const {
-        glBindVertexArray(0);
-    }
-
-    void VertexArray::addBuffer(const VertexBuffer& vb, const VertexBufferLayout& vbl) {
-        vb.bind();
-        const auto& elements = vbl.getElements();
-        unsigned int offset = 0;
-
-        for (unsigned int i = 0; i < elements.size(); i++) {
-            const auto& element = elements[i];
-            glEnableVertexAttribArray(i);
-            glVertexAttribPointer(
-                i,
-                element.count,
-                element.type,
-                element.normalized ? GL_TRUE : GL_FALSE,
-                static_cast<GLsizei>(vbl.getStride()),
-                reinterpret_cast<const void*>(static_cast<uintptr_t>(offset))
-            );
-            offset += element.count * VertexBufferElement::getSizeOfType(element.type);
-        }
-    }
-
-    // ======================== IndexBuffer ========================
-
-    IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count)
-        : count(count)
-    {
-        glGenBuffers(1, &rendererId);
-        bind();
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_STATIC_DRAW);
-    }
-
-    IndexBuffer::~IndexBuffer() {
-        glDeleteBuffers(1, &rendererId);
-    }
-
-    void IndexBuffer::bind() const {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, rendererId);
-    }
-
-    void IndexBuffer::unbind() const {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    }
-
-} // namespace vrtx
+/**
+ * @file Vertex.cpp
+ * @brief Implementazione delle classi per la gestione dei buffer di vertici e indici.
+ */
+
+#include "graphics/Vertex.h"
+#include "graphics/GLStateCache.h"
+
+namespace vrtx {
+
+    // ======================== Vertex ========================
+
+    Vertex::Vertex(const glm::vec2& pos, const glm::vec3& col)
+        : position(pos), color(col) {
+    }
+
+    // =================== VertexBufferElement ===================
+
+    VertexBufferElement::VertexBufferElement(unsigned int type, unsigned int count, bool normalized)
+        : type(type), count(count), normalized(normalized) {
+    }
+
+    unsigned int VertexBufferElement::getSizeOfType(unsigned int type) {
+        switch (type) {
+        case GL_FLOAT:         return sizeof(GLfloat);
+        case GL_UNSIGNED_INT:  return sizeof(GLuint);
+        case GL_UNSIGNED_BYTE: return sizeof(GLubyte);
+        default:               return 0;
+        }
+    }
+
+    // =================== VertexBufferLayout ===================
+
+    template<> void VertexBufferLayout::push<float>(int count) {
+        elements.emplace_back(GL_FLOAT, count, GL_FALSE);
+        stride += count * VertexBufferElement::getSizeOfType(GL_FLOAT);
+    }
+
+    template<> void VertexBufferLayout::push<unsigned int>(int count) {
+        elements.emplace_back(GL_UNSIGNED_INT, count, GL_FALSE);
+        stride += count * VertexBufferElement::getSizeOfType(GL_UNSIGNED_INT);
+    }
+
+    template<> void VertexBufferLayout::push<unsigned char>(int count) {
+        elements.emplace_back(GL_UNSIGNED_BYTE, count, GL_FALSE);
+        stride += count * VertexBufferElement::getSizeOfType(GL_UNSIGNED_BYTE);
+    }
+
+    unsigned int VertexBufferLayout::getStride() const { return stride; }
+    const std::vector<VertexBufferElement>& VertexBufferLayout::getElements() const { return elements; }
+
+    // ======================== VertexBuffer ========================
+
+    VertexBuffer::VertexBuffer(const void* data, unsigned int size) {
+        glGenBuffers(1, &rendererId);
+        bind();
+        glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+        capacity = size;
+    }
+
+    VertexBuffer::VertexBuffer(unsigned int capacity)
+        : capacity(capacity)
+    {
+        glGenBuffers(1, &rendererId);
+        bind();
+        glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+    }
+
+    VertexBuffer::~VertexBuffer() {
+        GLStateCache::onBufferDeleted(rendererId);
+        glDeleteBuffers(1, &rendererId);
+    }
+
+    void VertexBuffer::update(const void* data, unsigned int size) {
+        bind();
+        if (size > capacity) {
+            while (capacity < size) capacity = capacity > 0 ? capacity * 2 : size;
+        }
+        glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+    }
+
+    void VertexBuffer::bind() const {
+        GLStateCache::bindBuffer(GL_ARRAY_BUFFER, rendererId);
+    }
+
+    void VertexBuffer::unbind() const {
+        GLStateCache::bindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    // ======================== VertexArray ========================
+
+    VertexArray::VertexArray() {
+        glGenVertexArrays(1, &id);
+    }
+
+    VertexArray::~VertexArray() {
+        GLStateCache::onVertexArrayDeleted(id);
+        glDeleteVertexArrays(1, &id);
+    }
+
+    void VertexArray::bind() const {
+        GLStateCache::bindVertexArray(id);
+    }
+
+    void VertexArray::unbind() const {
+        GLStateCache::bindVertexArray(0);
+    }
+
+    void VertexArray::addBuffer(const VertexBuffer& vb, const VertexBufferLayout& vbl) {
+        setAttributes(vb, vbl, 0, 0);
+    }
+
+    void VertexArray::addInstanceBuffer(const VertexBuffer& vb, const VertexBufferLayout& vbl, unsigned int firstLocation) {
+        setAttributes(vb, vbl, firstLocation, 1);
+    }
+
+    void VertexArray::setAttributes(const VertexBuffer& vb, const VertexBufferLayout& vbl, unsigned int firstLocation, unsigned int divisor) {
+        vb.bind();
+        const auto& elements = vbl.getElements();
+        unsigned int offset = 0;
+
+        for (unsigned int i = 0; i < elements.size(); i++) {
+            const auto& element = elements[i];
+            const unsigned int location = firstLocation + i;
+            glEnableVertexAttribArray(location);
+            glVertexAttribPointer(
+                location,
+                element.count,
+                element.type,
+                element.normalized ? GL_TRUE : GL_FALSE,
+                static_cast<GLsizei>(vbl.getStride()),
+                reinterpret_cast<const void*>(static_cast<uintptr_t>(offset))
+            );
+            glVertexAttribDivisor(location, divisor);
+            offset += element.count * VertexBufferElement::getSizeOfType(element.type);
+        }
+    }
+
+    // ======================== IndexBuffer ========================
+
+    IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count)
+        : count(count)
+    {
+        glGenBuffers(1, &rendererId);
+
+        // Il binding dell'IBO modifica il VAO collegato: i VAO possono restare collegati
+        // tra un draw e l'altro, quindi si scollega prima di caricare i dati
+        GLStateCache::bindVertexArray(0);
+        bind();
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_STATIC_DRAW);
+    }
+
+    IndexBuffer::~IndexBuffer() {
+        GLStateCache::onBufferDeleted(rendererId);
+        glDeleteBuffers(1, &rendererId);
+    }
+
+    void IndexBuffer::bind() const {
+        GLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, rendererId);
+    }
+
+    void IndexBuffer::unbind() const {
+        GLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+
+    // ======================== UniformBuffer ========================
+
+    UniformBuffer::UniformBuffer(unsigned int size, unsigned int bindingPoint)
+        : size(size)
+    {
+        glGenBuffers(1, &rendererId);
+        bind();
+        glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, rendererId);
+    }
+
+    UniformBuffer::~UniformBuffer() {
+        GLStateCache::onBufferDeleted(rendererId);
+        glDeleteBuffers(1, &rendererId);
+    }
+
+    void UniformBuffer::update(const void* data, unsigned int dataSize) {
+        bind();
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, dataSize < size ? dataSize : size, data);
+    }
+
+    void UniformBuffer::bind() const {
+        GLStateCache::bindBuffer(GL_UNIFORM_BUFFER, rendererId);
+    }
+
+} // namespace vrtx
@@ -1,208 +1,391 @@
-#include "scene/Scene.h"
-#include <algorithm>
-#include "game/GameObject.h"
-#include "graphics/Renderer.h"
-#include "game/Projectile.h"
-#include "game/Obstacle.h"
-#include "game/Collision.h"
-#include "game/SpaceCleaner.h"
-
-/**
- * @brief Costruttore: inizializza il generatore casuale con un seed di sistema.
- */
-Scene::Scene() : randomEngine(std::random_device()()) {}
-
-/**
- * @brief Aggiunge una nuova entit attiva nella scena.
- */
-void Scene::addEntity(const std::shared_ptr<Entity>& entity) {
-    entities.push_back(entity);
-}
-
-/**
- * @brief Aggiorna tutte le entit e rimuove quelle inattive.
- *
- * Ogni entit riceve l'invocazione di `update(deltaTime)` per permettere
- * aggiornamenti interni (fisica, animazioni, vita residua, ecc.).
- *
- * Viene poi eseguita una pulizia tramite `std::remove_if` che elimina le entit
- * marcate come inattive.
- */
-void Scene::update(float deltaTime) {
-    for (auto& e : entities) {
-        if (e && e->isActive())
-            e->update(deltaTime);
-    }
-
-    // Pulizia delle entit non attive
-    entities.erase(std::remove_if(entities.begin(), entities.end(),
-        [](const std::shared_ptr<Entity>& e) {
-            return !e || !e->isActive();
-        }), entities.end());
-}
-
-/**
- * @brief Esegue il rendering di tutte le entit attive.
- */
-void Scene::render(Renderer& renderer, GLenum mode) {
-    for (auto& e : entities) {
-        if (e && e->isActive())
-            renderer.drawEntityByInfo(*e, mode);
-    }
-}
-
-/**
- * @brief Crea un proiettile con parametri fisici e grafici specifici.
- *
- * Il proiettile viene configurato con:
- *  - posizione iniziale;
- *  - velocit e direzione;
- *  - durata di vita (lifetime);
- *  - mesh, shader e colore.
- *
- * Il rendering  affidato al `SubMeshRenderInfo`, che memorizza gli ID di rendering.
- */
-void Scene::spawnProjectile(const glm::vec2& position, const glm::vec2& velocity,
-    float lifetime, unsigned int meshId,
-    unsigned int shaderId, const glm::vec4& color) {
-    auto proj = std::make_shared<Projectile>("Projectile");
-    proj->transform.setPosition(position);
-    proj->setVelocity(velocity);
-    proj->setLifetime(lifetime);
-
-    SubMeshRenderInfo info(meshId, shaderId, color);
-    info.localTransform = glm::mat4(1.0f);
-    proj->addMeshLayer(info);
-
-    addEntity(proj);
-}
-
-/**
- * @brief Rimuove tutte le entit attualmente nella scena.
- */
-void Scene::clear() {
-    entities.clear();
-}
-
-/**
- * @brief Genera nuovi ostacoli (asteroidi/comete) in modo casuale e periodico.
- *
- * Ogni `spawnCooldown` secondi, un nuovo oggetto viene creato:
- *  - la **posizione X**  casuale tra -1 e 1;
- *  - la **posizione Y**  fissa sopra lo schermo;
- *  - il **tipo**  deciso casualmente (50% asteroide / 50% cometa);
- *  - le **comete** sono pi veloci, mentre gli **asteroidi** hanno una rotazione casuale;
- *  - viene applicata una trasformazione di scala per il rendering.
- *
- * Lapproccio statistico crea una variet visiva e dinamica nel gameplay.
- */
-void Scene::updateSpawning(float deltaTime, unsigned int asteroidMeshId,
-    unsigned int cometMeshId, unsigned int shaderId) {
-    timeSinceLastSpawn += deltaTime;
-
-    if (timeSinceLastSpawn >= spawnCooldown) {
-        timeSinceLastSpawn = 0.0f;
-
-        float spawnX = xDist(randomEngine);
-        glm::vec2 position(spawnX, 1.25f); // appena fuori dallo schermo
-
-        // Determina tipo di oggetto
-        Obstacle::Type type = (typeDist(randomEngine) < 0.5f)
-            ? Obstacle::ASTEROID : Obstacle::COMET;
-
-        unsigned int meshId = (type == Obstacle::ASTEROID) ? asteroidMeshId : cometMeshId;
-        glm::vec4 color = (type == Obstacle::ASTEROID)
-            ? glm::vec4(0.5f, 0.4f, 0.3f, 1.0f)
-            : glm::vec4(0.8f, 0.9f, 1.0f, 1.0f);
-
-        auto obstacle = std::make_shared<Obstacle>(
-            (type == Obstacle::ASTEROID) ? "Asteroid" : "Comet", type);
-        obstacle->transform.setPosition(position);
-
-        float speed = (type == Obstacle::ASTEROID) ? 0.8f : 1.5f;
-        obstacle->setVelocity(glm::vec2(0.0f, -speed));
-
-        // Rotazione casuale per asteroidi
-        if (type == Obstacle::ASTEROID) {
-            std::uniform_real_distribution<float> rotDist(-1.5f, 1.5f);
-            obstacle->setRotationSpeed(rotDist(randomEngine));
-        }
-
-        SubMeshRenderInfo info(meshId, shaderId, color);
-        info.localTransform = glm::scale(glm::mat4(1.0f), glm::vec3(0.5f));
-        obstacle->addMeshLayer(info);
-
-        addEntity(obstacle);
-    }
-}
-
-/**
- * @brief Verifica e gestisce le collisioni tra entit.
- *
- * - I proiettili vengono controllati contro ogni ostacolo tramite le rispettive AABB.
- * - Le collisioni AABB sono calcolate nel sistema di coordinate del mondo.
- * - Quando una collisione  rilevata, le entit coinvolte vengono disattivate.
- * - Se il player collide con un ostacolo, subisce danno (chiamata `takeDamage()`).
- */
-void Scene::checkCollisions() {
-    std::vector<std::shared_ptr<Projectile>> projectiles;
-    std::vector<std::shared_ptr<Obstacle>> obstacles;
-    std::shared_ptr<Entity> playerRef = nullptr;
-
-    // Classifica entit per tipo dinamico
-    for (const auto& e : entities) {
-        if (e->isActive()) {
-            if (auto p = std::dynamic_pointer_cast<Projectile>(e)) {
-                projectiles.push_back(p);
-            }
-            else if (auto o = std::dynamic_pointer_cast<Obstacle>(e)) {
-                obstacles.push_back(o);
-            }
-            else if (e->getName() == "SpaceCleaner") {
-                playerRef = e;
-            }
-        }
-    }
-
-    // Proiettili vs ostacoli
-    for (const auto& proj : projectiles) {
-        if (proj->isActive()) {
-            AABB projBox = proj->getAABB();
-            for (const auto& obs : obstacles) {
-                if (obs->isActive()) {
-                    AABB obsBox = obs->getAABB();
-                    if (projBox.isColliding(obsBox)) {
-                        proj->setActive(false);
-                        obs->setActive(false);
-                        numCollisions++;
-                    }
-                }
-            }
-        }
-    }
-
-    // Player vs ostacoli
-    if (playerRef) {
-        AABB playerBox = playerRef->getAABB();
-        for (const auto& obs : obstacles) {
-            if (obs->isActive()) {
-                AABB obsBox = obs->getAABB();
-                if (playerBox.isColliding(obsBox)) {
-                    obs->setActive(false);
-                    if (auto playerCasted = std::dynamic_pointer_cast<SpaceCleaner>(playerRef)) {
-                        playerCasted->takeDamage();
-                    }
-                }
-            }
-        }
-    }
-}
-
-/**
- * @brief Restituisce il numero di collisioni e azzera il contatore.
- */
-int Scene::getCollisions() {
-    int temp = numCollisions;
-    numCollisions = 0;
-    return temp;
-}
+#include "scene/Scene.h"
+#include <algorithm>
+#include "game/GameObject.h"
+#include "graphics/Renderer.h"
+#include "game/Projectile.h"
+#include "game/Obstacle.h"
+#include "game/Collision.h"
+#include "game/SpaceCleaner.h"
+#include "core/JobSystem.h"
+
+/**
+ * @brief Costruttore: inizializza il generatore casuale con un seed di sistema.
+ */
+Scene::Scene() : randomEngine(std::random_device()()) {}
+
+/**
+ * @brief Aggiunge una nuova entità attiva nella scena.
+ */
+EntityHandle Scene::addEntity(const std::shared_ptr<Entity>& entity) {
+    if (!entity) return EntityHandle();
+    ownedEntities.push_back(entity);
+    return registerEntity(entity.get(), EntityOwner::Shared);
+}
+
+/**
+ * @brief Prende uno slot libero (o ne crea uno nuovo) e inserisce l'entità in coda al suo bucket.
+ */
+EntityHandle Scene::registerEntity(Entity* entity, EntityOwner owner) {
+    uint32_t index;
+    if (!freeSlots.empty()) {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else {
+        index = static_cast<uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+
+    EntityBucket& entities = bucket(entity->getKind());
+    EntitySlot& slot = slots[index];
+    slot.entity = entity;
+    slot.owner = owner;
+    slot.denseIndex = static_cast<uint32_t>(entities.size());
+    entities.push_back(entity);
+
+    entity->handle = EntityHandle{ index, slot.generation };
+    entity->transform.resetInterpolation();
+    entity->updateBounds();
+    return entity->handle;
+}
+
+/**
+ * @brief Risolve un handle confrontando la generazione con quella dello slot.
+ */
+Entity* Scene::getEntity(EntityHandle handle) const {
+    if (handle.index >= slots.size()) return nullptr;
+
+    const EntitySlot& slot = slots[handle.index];
+    return slot.generation == handle.generation ? slot.entity : nullptr;
+}
+
+/**
+ * @brief Disattiva subito l'entità (non collide e non viene disegnata) e rimanda la rimozione.
+ */
+void Scene::destroyEntity(EntityHandle handle) {
+    Entity* entity = getEntity(handle);
+    if (!entity) return;
+
+    entity->setActive(false);
+    pendingDestroy.push_back(handle);
+}
+
+/**
+ * @brief Concatena tutti i bucket in un'unica lista.
+ */
+std::vector<Entity*> Scene::getEntities() const {
+    std::vector<Entity*> all;
+    for (const auto& entities : buckets) {
+        all.insert(all.end(), entities.begin(), entities.end());
+    }
+    return all;
+}
+
+/**
+ * @brief Aggiorna tutte le entità e rimuove quelle inattive.
+ *
+ * Viene chiamata a passo fisso (vedi Timer::stepSimulation). Prima dell'update il transform
+ * di ogni entità salva lo stato precedente, usato dal renderer per interpolare.
+ *
+ * Ogni entità riceve l'invocazione di `update(deltaTime)` per permettere
+ * aggiornamenti interni (fisica, animazioni, vita residua, ecc.).
+ *
+ * Subito dopo viene ricalcolata l'AABB mondo in cache (`updateBounds()`): è l'unico
+ * punto del frame in cui si trasformano i bound delle mesh, le collisioni leggono la cache.
+ *
+ * Ogni bucket viene diviso in blocchi di `updateGrainSize` entità ed eseguito in parallelo
+ * sul JobSystem. L'update di un'entità scrive solo sull'entità stessa; le entità che
+ * risultano inattive finiscono nella lista del worker che le ha aggiornate, così nessun
+ * thread scrive su strutture condivise. Le liste vengono unite in `pendingDestroy` e
+ * le entità rimosse alla fine sul thread chiamante, insieme a quelle distrutte con
+ * `destroyEntity` (ad es. durante le collisioni del frame precedente).
+ */
+void Scene::update(float deltaTime) {
+    const unsigned workerCount = JobSystem::getWorkerCount();
+    if (workerDeadLists.size() < workerCount)
+        workerDeadLists.resize(workerCount);
+
+    for (auto& entities : buckets) {
+        JobSystem::parallelFor(entities.size(), updateGrainSize,
+            [&](size_t begin, size_t end, unsigned worker) {
+                std::vector<EntityHandle>& dead = workerDeadLists[worker];
+                for (size_t i = begin; i < end; ++i) {
+                    Entity* e = entities[i];
+                    if (e->isActive()) {
+                        e->transform.storePrevious();
+                        e->update(deltaTime);
+                        e->updateBounds();
+                    }
+
+                    if (!e->isActive())
+                        dead.push_back(e->handle);
+                }
+            });
+    }
+
+    for (auto& dead : workerDeadLists) {
+        pendingDestroy.insert(pendingDestroy.end(), dead.begin(), dead.end());
+        dead.clear();
+    }
+
+    flushDestroyed();
+}
+
+/**
+ * @brief Rimuove le entità accodate. Gli handle duplicati o già scaduti vengono ignorati.
+ */
+void Scene::flushDestroyed() {
+    for (EntityHandle handle : pendingDestroy) {
+        if (Entity* entity = getEntity(handle))
+            removeEntity(entity);
+    }
+    pendingDestroy.clear();
+}
+
+/**
+ * @brief Swap-and-pop: l'ultima entità del bucket prende il posto di quella rimossa.
+ *
+ * Lo slot viene liberato incrementandone la generazione, così ogni handle che
+ * punta ancora all'entità rimossa diventa non valido.
+ */
+void Scene::removeEntity(Entity* entity) {
+    const uint32_t index = entity->handle.index;
+    EntityBucket& entities = bucket(entity->getKind());
+
+    const uint32_t denseIndex = slots[index].denseIndex;
+    Entity* last = entities.back();
+    entities[denseIndex] = last;
+    slots[last->handle.index].denseIndex = denseIndex;
+    entities.pop_back();
+
+    EntitySlot& slot = slots[index];
+    const EntityOwner owner = slot.owner;
+    slot.entity = nullptr;
+    slot.generation++;
+    freeSlots.push_back(index);
+
+    entity->handle = EntityHandle();
+    releaseEntity(entity, owner);
+}
+
+/**
+ * @brief Restituisce un'entità rimossa dalla scena a chi ne possiede la memoria.
+ *
+ * Il proprietario è registrato nello slot: proiettili e ostacoli dei pool vengono
+ * rimessi nella free-list; le altre entità vengono tolte da `ownedEntities`,
+ * rilasciando lo shared_ptr.
+ */
+void Scene::releaseEntity(Entity* entity, EntityOwner owner) {
+    switch (owner) {
+    case EntityOwner::ProjectilePool:
+        projectilePool.release(static_cast<Projectile*>(entity));
+        return;
+    case EntityOwner::ObstaclePool:
+        obstaclePool.release(static_cast<Obstacle*>(entity));
+        return;
+    case EntityOwner::Shared:
+        break;
+    }
+
+    ownedEntities.erase(std::remove_if(ownedEntities.begin(), ownedEntities.end(),
+        [entity](const std::shared_ptr<Entity>& e) {
+            return e.get() == entity;
+        }), ownedEntities.end());
+}
+
+/**
+ * @brief Esegue il rendering delle entità attive e visibili (escluso il player).
+ *
+ * Le entità vengono solo accodate nella coda del renderer (layer World): il disegno
+ * avviene in Renderer::flush, dopo l'ordinamento per shader e mesh. Quelle la cui AABB
+ * in cache non interseca l'area visibile (es. ostacoli appena generati sopra lo schermo
+ * o in uscita verso i limiti di disattivazione) non vengono nemmeno accodate.
+ */
+void Scene::render(Renderer& renderer, const AABB& visibleBounds, GLenum mode) {
+    const glm::vec2 margin(CULL_MARGIN);
+    const AABB cullBounds(visibleBounds.min - margin, visibleBounds.max + margin);
+    cullStats = CullStats();
+
+    for (size_t k = 0; k < buckets.size(); ++k) {
+        if (static_cast<EntityKind>(k) == EntityKind::Player)
+            continue;
+
+        for (const auto& e : buckets[k]) {
+            if (!e->isActive())
+                continue;
+
+            if (cullingEnabled && !e->getAABB().isColliding(cullBounds)) {
+                cullStats.culled++;
+                continue;
+            }
+
+            renderer.submitEntity(*e, RenderLayer::World, mode);
+            cullStats.submitted++;
+        }
+    }
+}
+
+/**
+ * @brief Crea un proiettile con parametri fisici e grafici specifici.
+ *
+ * Il proiettile viene configurato con:
+ *  - posizione iniziale;
+ *  - velocità e direzione;
+ *  - durata di vita (lifetime);
+ *  - mesh, shader e colore.
+ *
+ * Il rendering è affidato al `SubMeshRenderInfo`, che memorizza gli ID di rendering.
+ * L'oggetto viene preso dal pool dei proiettili e reinizializzato in place.
+ */
+EntityHandle Scene::spawnProjectile(const glm::vec2& position, const glm::vec2& velocity,
+    float lifetime, unsigned int meshId,
+    unsigned int shaderId, const glm::vec4& color) {
+    Projectile* proj = projectilePool.acquire();
+    proj->reset(position, velocity, lifetime);
+
+    SubMeshRenderInfo info(meshId, shaderId, color);
+    info.localTransform = Affine2D::identity();
+    proj->clearMeshLayers();
+    proj->addMeshLayer(info);
+
+    return registerEntity(proj, EntityOwner::ProjectilePool);
+}
+
+/**
+ * @brief Rimuove tutte le entità attualmente nella scena.
+ */
+void Scene::clear() {
+    for (auto& entities : buckets) {
+        while (!entities.empty()) {
+            removeEntity(entities.back());
+        }
+    }
+    ownedEntities.clear();
+    pendingDestroy.clear();
+}
+
+/**
+ * @brief Genera nuovi ostacoli (asteroidi/comete) in modo casuale e periodico.
+ *
+ * Ogni `spawnCooldown` secondi, un nuovo oggetto viene creato:
+ *  - la **posizione X** è casuale tra -1 e 1;
+ *  - la **posizione Y** è fissa sopra lo schermo;
+ *  - il **tipo** è deciso casualmente (50% asteroide / 50% cometa);
+ *  - le **comete** sono più veloci, mentre gli **asteroidi** hanno una rotazione casuale;
+ *  - viene applicata una trasformazione di scala per il rendering.
+ *
+ * L’approccio statistico crea una varietà visiva e dinamica nel gameplay.
+ * Gli ostacoli vengono presi dal pool e reinizializzati in place.
+ */
+void Scene::updateSpawning(float deltaTime, unsigned int asteroidMeshId,
+    unsigned int cometMeshId, unsigned int shaderId) {
+    timeSinceLastSpawn += deltaTime;
+
+    if (timeSinceLastSpawn >= spawnCooldown) {
+        timeSinceLastSpawn = 0.0f;
+
+        float spawnX = xDist(randomEngine);
+        glm::vec2 position(spawnX, 1.25f); // appena fuori dallo schermo
+
+        // Determina tipo di oggetto
+        Obstacle::Type type = (typeDist(randomEngine) < 0.5f)
+            ? Obstacle::ASTEROID : Obstacle::COMET;
+
+        unsigned int meshId = (type == Obstacle::ASTEROID) ? asteroidMeshId : cometMeshId;
+        glm::vec4 color = (type == Obstacle::ASTEROID)
+            ? glm::vec4(0.5f, 0.4f, 0.3f, 1.0f)
+            : glm::vec4(0.8f, 0.9f, 1.0f, 1.0f);
+
+        float speed = (type == Obstacle::ASTEROID) ? 0.8f : 1.5f;
+
+        // Rotazione casuale per asteroidi
+        float rotationSpeed = 0.0f;
+        if (type == Obstacle::ASTEROID) {
+            std::uniform_real_distribution<float> rotDist(-1.5f, 1.5f);
+            rotationSpeed = rotDist(randomEngine);
+        }
+
+        spawnObstacle(type, position, glm::vec2(0.0f, -speed), rotationSpeed, meshId, shaderId, color);
+    }
+}
+
+/**
+ * @brief Crea un ostacolo prendendolo dal pool e reinizializzandolo in place.
+ */
+EntityHandle Scene::spawnObstacle(Obstacle::Type type, const glm::vec2& position,
+    const glm::vec2& velocity, float rotationSpeed, unsigned int meshId,
+    unsigned int shaderId, const glm::vec4& color) {
+    Obstacle* obstacle = obstaclePool.acquire();
+    obstacle->reset((type == Obstacle::ASTEROID) ? "Asteroid" : "Comet", type,
+        position, velocity);
+    obstacle->setRotationSpeed(rotationSpeed);
+
+    SubMeshRenderInfo info(meshId, shaderId, color);
+    info.localTransform = Affine2D::scaling(0.5f);
+    obstacle->clearMeshLayers();
+    obstacle->addMeshLayer(info);
+
+    return registerEntity(obstacle, EntityOwner::ObstaclePool);
+}
+
+/**
+ * @brief Verifica e gestisce le collisioni tra entità.
+ *
+ * - Gli ostacoli attivi vengono inseriti nella griglia uniforme con la loro AABB (in cache da update()).
+ * - Proiettili e player interrogano la griglia e vengono testati solo contro gli ostacoli vicini
+ *   il cui layer rientra nella loro maschera di collisione.
+ * - Le collisioni AABB sono calcolate nel sistema di coordinate del mondo.
+ * - Quando una collisione è rilevata, le entità coinvolte vengono distrutte (`destroyEntity`).
+ * - Se il player collide con un ostacolo, subisce danno (chiamata `takeDamage()`).
+ *
+ * I bucket contengono solo entità del tipo corrispondente, quindi i cast sono statici.
+ */
+void Scene::checkCollisions() {
+    const EntityBucket& obstacles = bucket(EntityKind::Obstacle);
+
+    // Broadphase: l'indice nella griglia coincide con l'indice nel bucket degli ostacoli
+    broadphase.clear();
+    for (const auto& obs : obstacles) {
+        broadphase.insert(obs->isActive() ? obs->getAABB() : AABB());
+    }
+    broadphase.build();
+
+    // Proiettili vs ostacoli
+    for (const auto& proj : bucket(EntityKind::Projectile)) {
+        if (proj->isActive()) {
+            AABB projBox = proj->getAABB();
+            broadphase.query(projBox, [&](uint32_t index) {
+                Entity* obs = obstacles[index];
+                if (obs->isActive() && proj->collidesWith(*obs) && projBox.isColliding(broadphase.getBox(index))) {
+                    destroyEntity(proj->getHandle());
+                    destroyEntity(obs->getHandle());
+                    numCollisions++;
+                }
+            });
+        }
+    }
+
+    // Player vs ostacoli
+    for (Entity* playerRef : bucket(EntityKind::Player)) {
+        if (!playerRef->isActive()) continue;
+
+        SpaceCleaner* player = static_cast<SpaceCleaner*>(playerRef);
+        AABB playerBox = player->getAABB();
+        broadphase.query(playerBox, [&](uint32_t index) {
+            Entity* obs = obstacles[index];
+            if (obs->isActive() && player->collidesWith(*obs) && playerBox.isColliding(broadphase.getBox(index))) {
+                destroyEntity(obs->getHandle());
+                player->takeDamage();
+            }
+        });
+    }
+}
+
+/**
+ * @brief Restituisce il numero di collisioni e azzera il contatore.
+ */
+int Scene::getCollisions() {
+    int temp = numCollisions;
+    numCollisions = 0;
+    return temp;
+}
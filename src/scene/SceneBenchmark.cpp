@@ -0,0 +1,132 @@
+#include "scene/SceneBenchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+#include "scene/SpatialGrid.h"
+#include "scene/Scene.h"
+#include "game/Collision.h"
+#include "core/JobSystem.h"
+
+namespace {
+    // Entità per unità quadrata di mondo: il mondo cresce con il numero di entità
+    constexpr float ENTITY_DENSITY = 8.0f;
+    constexpr int ITERATIONS = 5;
+    // Passi di Scene::update per misura: gli ostacoli restano dentro i limiti di gioco
+    constexpr int UPDATE_STEPS = 30;
+    constexpr float UPDATE_DT = 1.0f / 60.0f;
+
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    /**
+     * @brief Genera AABB con dimensioni simili a quelle di gioco
+     * (ostacoli ~0.3-0.6, proiettili ~0.03x0.1).
+     */
+    void generateBoxes(int count, std::mt19937& rng, std::vector<AABB>& projectiles, std::vector<AABB>& obstacles) {
+        const float worldSize = std::sqrt(static_cast<float>(count) / ENTITY_DENSITY);
+        std::uniform_real_distribution<float> posDist(-worldSize * 0.5f, worldSize * 0.5f);
+        std::uniform_real_distribution<float> sizeDist(0.3f, 0.6f);
+
+        projectiles.clear();
+        obstacles.clear();
+        for (int i = 0; i < count; ++i) {
+            glm::vec2 center(posDist(rng), posDist(rng));
+            if (i % 2 == 0) {
+                glm::vec2 half(0.015f, 0.05f);
+                projectiles.emplace_back(center - half, center + half);
+            }
+            else {
+                glm::vec2 half(sizeDist(rng) * 0.5f);
+                obstacles.emplace_back(center - half, center + half);
+            }
+        }
+    }
+}
+
+std::vector<BroadphaseBenchmarkResult> SceneBenchmark::runBroadphase(const std::vector<int>& entityCounts, int bruteForceLimit) {
+    std::vector<BroadphaseBenchmarkResult> results;
+    std::mt19937 rng(1234);
+    std::vector<AABB> projectiles;
+    std::vector<AABB> obstacles;
+    SpatialGrid grid;
+
+    for (int count : entityCounts) {
+        BroadphaseBenchmarkResult result;
+        result.entityCount = count;
+        generateBoxes(count, rng, projectiles, obstacles);
+
+        // Griglia uniforme: build + una query per proiettile (come Scene::checkCollisions)
+        auto start = Clock::now();
+        for (int it = 0; it < ITERATIONS; ++it) {
+            int pairs = 0;
+            grid.clear();
+            for (const auto& box : obstacles) grid.insert(box);
+            grid.build();
+
+            for (const auto& projBox : projectiles) {
+                grid.query(projBox, [&](uint32_t index) {
+                    if (projBox.isColliding(grid.getBox(index))) pairs++;
+                });
+            }
+            result.collidingPairs = pairs;
+        }
+        result.gridMs = elapsedMs(start) / ITERATIONS;
+
+        // Confronto con il doppio ciclo originale, solo per dimensioni ragionevoli
+        if (count <= bruteForceLimit) {
+            start = Clock::now();
+            volatile int pairs = 0;
+            for (const auto& projBox : projectiles)
+                for (const auto& obsBox : obstacles)
+                    if (projBox.isColliding(obsBox)) pairs = pairs + 1;
+            result.bruteForceMs = elapsedMs(start);
+        }
+
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+std::vector<ParallelUpdateBenchmarkResult> SceneBenchmark::runParallelUpdate(
+    const std::vector<unsigned>& threadCounts, int entityCount, unsigned int meshId) {
+    std::vector<ParallelUpdateBenchmarkResult> results;
+    const unsigned previousWorkers = JobSystem::getWorkerCount();
+    const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned threads : threadCounts) {
+        if (threads == 0 || threads > hardwareThreads) continue;
+        JobSystem::init(threads);
+
+        // Stessa scena per ogni misura: ostacoli sparsi in [-4, 4], lenti abbastanza da non uscire
+        Scene scene;
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> posDist(-4.0f, 4.0f);
+        std::uniform_real_distribution<float> velDist(-0.8f, 0.8f);
+        std::uniform_real_distribution<float> rotDist(-1.5f, 1.5f);
+        for (int i = 0; i < entityCount; ++i) {
+            scene.spawnObstacle(Obstacle::ASTEROID, glm::vec2(posDist(rng), posDist(rng)),
+                glm::vec2(velDist(rng), velDist(rng)), rotDist(rng), meshId, 0, glm::vec4(1.0f));
+        }
+
+        auto start = Clock::now();
+        for (int step = 0; step < UPDATE_STEPS; ++step) {
+            scene.update(UPDATE_DT);
+        }
+
+        ParallelUpdateBenchmarkResult result;
+        result.threadCount = threads;
+        result.updateMs = elapsedMs(start) / UPDATE_STEPS;
+        if (!results.empty() && result.updateMs > 0.0)
+            result.speedup = results.front().updateMs / result.updateMs;
+        results.push_back(result);
+    }
+
+    JobSystem::init(previousWorkers);
+    return results;
+}
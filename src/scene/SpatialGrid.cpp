@@ -0,0 +1,111 @@
+#include "scene/SpatialGrid.h"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+    // Limite sulle coordinate di cella: evita overflow con AABB degeneri o enormi
+    constexpr float MAX_CELL_COORD = static_cast<float>(1 << 20);
+
+    int toCell(float value, float invCellSize) {
+        float cell = std::floor(value * invCellSize);
+        cell = std::max(-MAX_CELL_COORD, std::min(MAX_CELL_COORD, cell));
+        return static_cast<int>(cell);
+    }
+}
+
+SpatialGrid::SpatialGrid(float cellSize) {
+    setCellSize(cellSize);
+}
+
+void SpatialGrid::setCellSize(float size) {
+    cellSize = size > 0.0f ? size : 0.5f;
+    invCellSize = 1.0f / cellSize;
+}
+
+void SpatialGrid::clear() {
+    boxes.clear();
+    bucketItems.clear();
+    bucketStart.clear();
+    cellEntries = 0;
+}
+
+SpatialGrid::CellRange SpatialGrid::cellRange(const AABB& box) const {
+    return {
+        toCell(box.min.x, invCellSize), toCell(box.min.y, invCellSize),
+        toCell(box.max.x, invCellSize), toCell(box.max.y, invCellSize)
+    };
+}
+
+/**
+ * @brief Mappa una cella (cx, cy) su un bucket tramite hash spaziale.
+ */
+uint32_t SpatialGrid::bucketOf(int cellX, int cellY) const {
+    const uint32_t h = (static_cast<uint32_t>(cellX) * 73856093u) ^ (static_cast<uint32_t>(cellY) * 19349663u);
+    return h & bucketMask;
+}
+
+/**
+ * @brief Registra l'AABB e accumula il numero di celle che copre.
+ *
+ * Le AABB vuote (min > max) vengono comunque memorizzate per mantenere
+ * l'indicizzazione per ordine di inserimento, ma non occupano celle.
+ */
+void SpatialGrid::insert(const AABB& box) {
+    boxes.push_back(box);
+
+    if (box.min.x > box.max.x || box.min.y > box.max.y) {
+        return;
+    }
+
+    const CellRange range = cellRange(box);
+    cellEntries += static_cast<size_t>(range.maxX - range.minX + 1) * static_cast<size_t>(range.maxY - range.minY + 1);
+}
+
+/**
+ * @brief Costruisce i bucket con un counting sort in tre passate:
+ *  1. conta quanti elementi finiscono in ogni bucket;
+ *  2. calcola la prefix sum per ottenere l'inizio di ogni bucket;
+ *  3. scrive gli indici degli elementi nella posizione finale.
+ *
+ * Il numero di bucket è la potenza di due successiva al doppio delle coppie
+ * (elemento, cella), così da mantenere basso il numero di collisioni di hash.
+ */
+void SpatialGrid::build() {
+    uint32_t bucketCount = 16;
+    while (bucketCount < cellEntries * 2) {
+        bucketCount <<= 1;
+    }
+    bucketMask = bucketCount - 1;
+
+    bucketStart.assign(bucketCount + 1, 0);
+    bucketItems.resize(cellEntries);
+    visitStamp.assign(boxes.size(), 0);
+    currentStamp = 0;
+
+    // 1. Conteggio
+    for (const auto& box : boxes) {
+        if (box.min.x > box.max.x || box.min.y > box.max.y) continue;
+
+        const CellRange range = cellRange(box);
+        for (int cy = range.minY; cy <= range.maxY; ++cy)
+            for (int cx = range.minX; cx <= range.maxX; ++cx)
+                bucketStart[bucketOf(cx, cy) + 1]++;
+    }
+
+    // 2. Prefix sum
+    for (uint32_t b = 0; b < bucketCount; ++b) {
+        bucketStart[b + 1] += bucketStart[b];
+    }
+
+    // 3. Scrittura (il cursore parte dall'inizio di ogni bucket)
+    writeCursor.assign(bucketStart.begin(), bucketStart.end() - 1);
+    for (uint32_t index = 0; index < boxes.size(); ++index) {
+        const AABB& box = boxes[index];
+        if (box.min.x > box.max.x || box.min.y > box.max.y) continue;
+
+        const CellRange range = cellRange(box);
+        for (int cy = range.minY; cy <= range.maxY; ++cy)
+            for (int cx = range.minX; cx <= range.maxX; ++cx)
+                bucketItems[writeCursor[bucketOf(cx, cy)]++] = index;
+    }
+}
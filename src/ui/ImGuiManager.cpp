@@ -1,167 +1,380 @@
-#include "ui/ImGuiManager.h"
-#include "core/Engine.h"
-#include "core/BackGround.h"
-#include "core/Window.h"
-
-/**
- * @brief Costruttore: inizializza ImGui e i backend GLFW/OpenGL.
- */
-ImGuiManager::ImGuiManager(GLFWwindow* window) {
-    IMGUI_CHECKVERSION();
-    ImGui::CreateContext();
-    ImGuiIO& io = ImGui::GetIO();
-    io.FontGlobalScale = 2.0f; // ingrandisce font di default
-    ImGui::StyleColorsDark();   // tema scuro
-
-    // Inizializzazione backend
-    ImGui_ImplGlfw_InitForOpenGL(window, true);
-    ImGui_ImplOpenGL3_Init("#version 330");
-}
-
-/**
- * @brief Distruttore: esegue il cleanup completo di ImGui.
- */
-ImGuiManager::~ImGuiManager() {
-    ImGui_ImplOpenGL3_Shutdown();
-    ImGui_ImplGlfw_Shutdown();
-    ImGui::DestroyContext();
-}
-
-/**
- * @brief Inizia un nuovo frame ImGui (preparazione rendering GUI).
- */
-void ImGuiManager::beginFrame() {
-    ImGui_ImplOpenGL3_NewFrame();
-    ImGui_ImplGlfw_NewFrame();
-    ImGui::NewFrame();
-}
-
-/**
- * @brief Termina il frame e invia i dati di rendering a OpenGL.
- */
-void ImGuiManager::endFrame() {
-    ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-}
-
-/**
- * @brief Disegna il menu di pausa centrato nello schermo.
- *
- * Include pulsanti per riprendere, ricominciare o uscire dal gioco.
- */
-void ImGuiManager::drawPauseMenu(Engine* engine) {
-    ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x * 0.5f,
-        ImGui::GetIO().DisplaySize.y * 0.5f),
-        ImGuiCond_Always, ImVec2(0.5f, 0.5f));
-    ImGui::SetNextWindowSize(ImVec2(350, 180));
-    ImGuiWindowFlags windowFlags =
-        ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove;
-
-    if (ImGui::Begin("PauseMenu", nullptr, windowFlags)) {
-        ImGui::TextColored(ImVec4(1, 1, 0, 1), "  >> GIOCO IN PAUSA <<");
-        ImGui::Separator();
-        if (ImGui::Button("Riprendi", ImVec2(-1, 0))) engine->setCurrentState(PLAYING);
-        if (ImGui::Button("Ricomincia", ImVec2(-1, 0))) engine->resetGame();
-        if (ImGui::Button("Esci dal Gioco", ImVec2(-1, 0))) {
-            if (engine && engine->window) engine->window->setShouldClose(true);
-        }
-    }
-    ImGui::End();
-}
-
-/**
- * @brief Disegna il menu Game Over centrato nello schermo.
- *
- * Mostra il punteggio e pulsanti per riprovare o uscire.
- */
-void ImGuiManager::drawGameOverMenu(Engine* engine) {
-    ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x * 0.5f,
-        ImGui::GetIO().DisplaySize.y * 0.5f),
-        ImGuiCond_Always, ImVec2(0.5f, 0.5f));
-    ImGuiWindowFlags windowFlags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize;
-
-    if (ImGui::Begin("GameOver", nullptr, windowFlags)) {
-        ImGui::TextColored(ImVec4(1, 0, 0, 1), "  >>> G A M E   O V E R <<<");
-        ImGui::Separator();
-        ImGui::Text("Punti totali: %d", engine->getScore());
-        ImGui::Separator();
-        if (ImGui::Button("Riprova (R)", ImVec2(-1, 0))) engine->resetGame();
-        if (ImGui::Button("Esci", ImVec2(-1, 0))) {
-            if (engine && engine->window) engine->window->setShouldClose(true);
-        }
-    }
-    ImGui::End();
-}
-
-/**
- * @brief Disegna il menu di Start centrato nello schermo.
- *
- * Include pulsanti per avviare il gioco o uscire e mostra informazioni base.
- */
-void ImGuiManager::drawStartMenu(Engine* engine) {
-    ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x * 0.5f,
-        ImGui::GetIO().DisplaySize.y * 0.5f),
-        ImGuiCond_Always, ImVec2(0.5f, 0.5f));
-    ImGui::SetNextWindowSize(ImVec2(600, 310));
-    ImGuiWindowFlags windowFlags = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove;
-
-    if (ImGui::Begin("StartMenu", nullptr, windowFlags)) {
-        ImGui::TextColored(ImVec4(0, 0.8f, 1, 1), "  >> SPACECLEANER <<");
-        ImGui::Separator();
-        ImGui::Text("WASD -> movimento");
-        ImGui::Text("Spazio -> spara proiettili");
-        ImGui::Text("F1 -> editor");
-        ImGui::Text("Esc -> pausa");
-        ImGui::Text("Spara agli ostacoli per ottenere");
-		ImGui::Text("un punteggio migliore");
-        ImGui::Separator();
-
-        if (ImGui::Button("Avvia Partita", ImVec2(-1, 0))) {
-            engine->setCurrentState(PLAYING);
-            engine->resetGame();
-        }
-
-        if (ImGui::Button("Esci", ImVec2(-1, 0))) {
-            if (engine && engine->window) engine->window->setShouldClose(true);
-        }
-    }
-    ImGui::End();
-}
-
-/**
- * @brief Disegna la finestra editor per controlli runtime.
- *
- * Consente di modificare modalit wireframe, mostrare bounding box, selezionare player/shader
- * e visualizzare lo score corrente.
- */
-void ImGuiManager::drawEditorWindow(Engine* engine) {
-    ImGui::Begin("SpaceCleaner Editor");
-
-    ImGui::Text("Controlli di rendering");
-    if (ImGui::Checkbox("Wireframe Mode", &wireframeMode))
-        glPolygonMode(GL_FRONT_AND_BACK, wireframeMode ? GL_LINE : GL_FILL);
-    ImGui::Checkbox("Bounding Box Mode", &boundingBoxMode);
-
-    ImGui::Separator();
-    ImGui::Text("Scelta giocatore");
-    std::vector<const char*> playerItems;
-    for (const auto& config : engine->playerConfigs) playerItems.push_back(config.name.c_str());
-
-    if (!playerItems.empty())
-        ImGui::Combo("Player Model", (int*)&currentPlayerSelection, playerItems.data(), (int)playerItems.size());
-    else
-        ImGui::TextDisabled("Nessun modello di player configurato.");
-
-    std::vector<const char*> bgItems;
-    for (const auto& config : engine->backgroundConfigs) bgItems.push_back(config.name.c_str());
-
-    if (!bgItems.empty())
-        ImGui::Combo("Shader Select", (int*)&currentBackgroundSelection, bgItems.data(), (int)bgItems.size());
-    else
-        ImGui::TextDisabled("Nessun background configurato.");
-
-    ImGui::Separator();
-    ImGui::Text("Current Score: %d", engine->getScore());
-    ImGui::Separator();
-    ImGui::End();
-}
+#include "ui/ImGuiManager.h"
+#include "core/Engine.h"
+#include "core/BackGround.h"
+#include "core/Window.h"
+#include "scene/Scene.h"
+#include "graphics/Renderer.h"
+#include "graphics/BackgroundPass.h"
+#include "graphics/DynamicResolution.h"
+#include "graphics/GLStateCache.h"
+#include "graphics/MeshManager.h"
+#include "utilities/Timer.h"
+#include "core/JobSystem.h"
+
+/**
+ * @brief Costruttore: inizializza ImGui e i backend GLFW/OpenGL.
+ */
+ImGuiManager::ImGuiManager(GLFWwindow* window) {
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.FontGlobalScale = 2.0f; // ingrandisce font di default
+    ImGui::StyleColorsDark();   // tema scuro
+
+    // Inizializzazione backend
+    ImGui_ImplGlfw_InitForOpenGL(window, true);
+    ImGui_ImplOpenGL3_Init("#version 330");
+}
+
+/**
+ * @brief Distruttore: esegue il cleanup completo di ImGui.
+ */
+ImGuiManager::~ImGuiManager() {
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui_ImplGlfw_Shutdown();
+    ImGui::DestroyContext();
+}
+
+/**
+ * @brief Inizia un nuovo frame ImGui (preparazione rendering GUI).
+ */
+void ImGuiManager::beginFrame() {
+    ImGui_ImplOpenGL3_NewFrame();
+    ImGui_ImplGlfw_NewFrame();
+    ImGui::NewFrame();
+}
+
+/**
+ * @brief Termina il frame e invia i dati di rendering a OpenGL.
+ */
+void ImGuiManager::endFrame() {
+    ImGui::Render();
+    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+}
+
+/**
+ * @brief Disegna il menu di pausa centrato nello schermo.
+ *
+ * Include pulsanti per riprendere, ricominciare o uscire dal gioco.
+ */
+void ImGuiManager::drawPauseMenu(Engine* engine) {
+    ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x * 0.5f,
+        ImGui::GetIO().DisplaySize.y * 0.5f),
+        ImGuiCond_Always, ImVec2(0.5f, 0.5f));
+    ImGui::SetNextWindowSize(ImVec2(350, 180));
+    ImGuiWindowFlags windowFlags =
+        ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove;
+
+    if (ImGui::Begin("PauseMenu", nullptr, windowFlags)) {
+        ImGui::TextColored(ImVec4(1, 1, 0, 1), "  >> GIOCO IN PAUSA <<");
+        ImGui::Separator();
+        if (ImGui::Button("Riprendi", ImVec2(-1, 0))) engine->setCurrentState(PLAYING);
+        if (ImGui::Button("Ricomincia", ImVec2(-1, 0))) engine->resetGame();
+        if (ImGui::Button("Esci dal Gioco", ImVec2(-1, 0))) {
+            if (engine && engine->window) engine->window->setShouldClose(true);
+        }
+    }
+    ImGui::End();
+}
+
+/**
+ * @brief Disegna il menu Game Over centrato nello schermo.
+ *
+ * Mostra il punteggio e pulsanti per riprovare o uscire.
+ */
+void ImGuiManager::drawGameOverMenu(Engine* engine) {
+    ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x * 0.5f,
+        ImGui::GetIO().DisplaySize.y * 0.5f),
+        ImGuiCond_Always, ImVec2(0.5f, 0.5f));
+    ImGuiWindowFlags windowFlags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize;
+
+    if (ImGui::Begin("GameOver", nullptr, windowFlags)) {
+        ImGui::TextColored(ImVec4(1, 0, 0, 1), "  >>> G A M E   O V E R <<<");
+        ImGui::Separator();
+        ImGui::Text("Punti totali: %d", engine->getScore());
+        ImGui::Separator();
+        if (ImGui::Button("Riprova (R)", ImVec2(-1, 0))) engine->resetGame();
+        if (ImGui::Button("Esci", ImVec2(-1, 0))) {
+            if (engine && engine->window) engine->window->setShouldClose(true);
+        }
+    }
+    ImGui::End();
+}
+
+/**
+ * @brief Disegna il menu di Start centrato nello schermo.
+ *
+ * Include pulsanti per avviare il gioco o uscire e mostra informazioni base.
+ */
+void ImGuiManager::drawStartMenu(Engine* engine) {
+    ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x * 0.5f,
+        ImGui::GetIO().DisplaySize.y * 0.5f),
+        ImGuiCond_Always, ImVec2(0.5f, 0.5f));
+    ImGui::SetNextWindowSize(ImVec2(600, 310));
+    ImGuiWindowFlags windowFlags = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove;
+
+    if (ImGui::Begin("StartMenu", nullptr, windowFlags)) {
+        ImGui::TextColored(ImVec4(0, 0.8f, 1, 1), "  >> SPACECLEANER <<");
+        ImGui::Separator();
+        ImGui::Text("WASD -> movimento");
+        ImGui::Text("Spazio -> spara proiettili");
+        ImGui::Text("F1 -> editor");
+        ImGui::Text("Esc -> pausa");
+        ImGui::Text("Spara agli ostacoli per ottenere");
+		ImGui::Text("un punteggio migliore");
+        ImGui::Separator();
+
+        if (ImGui::Button("Avvia Partita", ImVec2(-1, 0))) {
+            engine->setCurrentState(PLAYING);
+            engine->resetGame();
+        }
+
+        if (ImGui::Button("Esci", ImVec2(-1, 0))) {
+            if (engine && engine->window) engine->window->setShouldClose(true);
+        }
+    }
+    ImGui::End();
+}
+
+/**
+ * @brief Disegna la finestra editor per controlli runtime.
+ *
+ * Consente di modificare modalità wireframe, mostrare bounding box, selezionare player/shader
+ * e visualizzare lo score corrente.
+ */
+void ImGuiManager::drawEditorWindow(Engine* engine) {
+    ImGui::Begin("SpaceCleaner Editor");
+
+    ImGui::Text("Controlli di rendering");
+    if (ImGui::Checkbox("Wireframe Mode", &wireframeMode))
+        GLStateCache::setPolygonMode(wireframeMode ? GL_LINE : GL_FILL);
+    ImGui::Checkbox("Bounding Box Mode", &boundingBoxMode);
+
+    ImGui::Separator();
+    ImGui::Text("Scelta giocatore");
+    std::vector<const char*> playerItems;
+    for (const auto& config : engine->playerConfigs) playerItems.push_back(config.name.c_str());
+
+    if (!playerItems.empty())
+        ImGui::Combo("Player Model", (int*)&currentPlayerSelection, playerItems.data(), (int)playerItems.size());
+    else
+        ImGui::TextDisabled("Nessun modello di player configurato.");
+
+    std::vector<const char*> bgItems;
+    for (const auto& config : engine->backgroundConfigs) bgItems.push_back(config.name.c_str());
+
+    if (!bgItems.empty())
+        ImGui::Combo("Shader Select", (int*)&currentBackgroundSelection, bgItems.data(), (int)bgItems.size());
+    else
+        ImGui::TextDisabled("Nessun background configurato.");
+
+    // Risoluzione e frequenza di aggiornamento dello sfondo (1.0 e 1 = diretto sullo schermo)
+    if (BackgroundPass* backgroundPass = engine->getBackgroundPass()) {
+        float bgScale = backgroundPass->getScale();
+        if (ImGui::SliderFloat("Scala sfondo", &bgScale, BackgroundPass::MIN_SCALE, BackgroundPass::MAX_SCALE, "%.2f"))
+            backgroundPass->setScale(bgScale);
+
+        int bgInterval = backgroundPass->getRefreshInterval();
+        if (ImGui::SliderInt("Aggiorna ogni N frame", &bgInterval, 1, BackgroundPass::MAX_REFRESH_INTERVAL))
+            backgroundPass->setRefreshInterval(bgInterval);
+
+        const glm::ivec2 bgSize = backgroundPass->getTargetSize();
+        ImGui::Text("Sfondo: %dx%d %s, GPU %.3f ms", bgSize.x, bgSize.y,
+            backgroundPass->isOffscreen() ? "(FBO)" : "(diretto)", backgroundPass->getGpuMilliseconds());
+    }
+
+    ImGui::Separator();
+    ImGui::Text("Current Score: %d", engine->getScore());
+    ImGui::Separator();
+    drawTimingSection(engine);
+    drawRenderStatsSection(engine);
+    drawPoolSection(engine);
+    drawBenchmarkSection(engine);
+    ImGui::End();
+}
+
+/**
+ * @brief Controlli di temporizzazione: frequenza della simulazione, passi massimi
+ * di recupero per frame, V-Sync e limite FPS del rendering.
+ */
+void ImGuiManager::drawTimingSection(Engine* engine) {
+    if (!ImGui::CollapsingHeader("Timing")) return;
+
+    Timer::State& timer = Timer::state();
+
+    int simHz = static_cast<int>(timer.simulationHz);
+    if (ImGui::SliderInt("Simulazione (Hz)", &simHz, 20, 240))
+        Timer::setSimulationRate(simHz);
+
+    int maxSteps = timer.maxCatchUpSteps;
+    if (ImGui::SliderInt("Passi max/frame", &maxSteps, 1, 10))
+        Timer::setMaxCatchUpSteps(maxSteps);
+
+    int fpsCap = static_cast<int>(timer.frameRateCap);
+    if (ImGui::SliderInt("Limite FPS (0 = off)", &fpsCap, 0, 240))
+        Timer::setFrameRateCap(fpsCap);
+
+    if (engine->window) {
+        bool vsync = engine->window->isVSyncEnabled();
+        if (ImGui::Checkbox("V-Sync", &vsync))
+            engine->window->setVSync(vsync);
+    }
+
+    ImGui::Text("FPS: %.1f  Passi ultimo frame: %d", Timer::getCurrentFPS(), timer.lastFrameSteps);
+    ImGui::Text("Passi scartati: %llu  Alpha: %.2f", timer.droppedSteps, Timer::getInterpolationAlpha());
+}
+
+/**
+ * @brief Contatori di rendering dell'ultimo frame.
+ *
+ * "Senza instancing" è il numero di chiamate che servirebbero disegnando ogni
+ * sub-mesh separatamente: la differenza con le chiamate effettive è il risparmio.
+ * I cambi evitati sono i pacchetti della coda che hanno trovato programma o VAO già collegati;
+ * le chiamate eliminate sono quelle saltate da GLStateCache e dalle copie delle uniform.
+ */
+void ImGuiManager::drawRenderStatsSection(Engine* engine) {
+    Renderer* renderer = engine->getRenderer();
+    if (!renderer || !ImGui::CollapsingHeader("Rendering")) return;
+
+    const RenderStats& stats = renderer->getStats();
+    ImGui::Text("Draw call: %u (instanced: %u)", stats.drawCalls, stats.instancedDrawCalls);
+    ImGui::Text("Istanze: %u", stats.instances);
+    ImGui::Text("Senza instancing: %u  Risparmiate: %u", stats.subMeshes,
+        stats.subMeshes > stats.drawCalls ? stats.subMeshes - stats.drawCalls : 0u);
+
+    if (Scene* scene = engine->getScene()) {
+        ImGui::Separator();
+        bool culling = scene->isCullingEnabled();
+        if (ImGui::Checkbox("Culling entita' fuori schermo", &culling))
+            scene->setCullingEnabled(culling);
+        const CullStats& cull = scene->getCullStats();
+        ImGui::Text("Entita' accodate: %u  scartate: %u", cull.submitted, cull.culled);
+    }
+
+    if (DynamicResolution* dynamicResolution = engine->getDynamicResolution()) {
+        ImGui::Separator();
+        bool dynamicEnabled = dynamicResolution->isEnabled();
+        if (ImGui::Checkbox("Risoluzione dinamica", &dynamicEnabled))
+            dynamicResolution->setEnabled(dynamicEnabled);
+
+        float budget = dynamicResolution->getBudgetMilliseconds();
+        if (ImGui::SliderFloat("Budget GPU (ms)", &budget, 1.0f, 33.0f, "%.1f"))
+            dynamicResolution->setBudgetMilliseconds(budget);
+
+        const glm::ivec2 renderSize = dynamicResolution->getRenderSize();
+        ImGui::Text("Scala: %.2f (%dx%d)  GPU frame: %.3f ms", dynamicResolution->getScale(),
+            renderSize.x, renderSize.y, dynamicResolution->getGpuMilliseconds());
+    }
+
+    ImGui::Separator();
+    ImGui::Text("Pacchetti in coda: %u", stats.packets);
+    ImGui::Text("Cambi programma: %u  evitati: %u", stats.programBinds, stats.programBindsSkipped);
+    ImGui::Text("Cambi VAO: %u  evitati: %u", stats.vaoBinds, stats.vaoBindsSkipped);
+    ImGui::Text("Linee di debug: %u", stats.debugLines);
+
+    const GLStateStats& gl = GLStateCache::getLastFrameStats();
+    ImGui::Separator();
+    ImGui::Text("Chiamate GL di stato: %u  eliminate: %u", gl.stateIssued, gl.stateElided);
+    ImGui::Text("Upload uniform: %u  eliminati: %u", gl.uniformsIssued, gl.uniformsElided);
+
+    const GeometryArenaStats arena = MeshManager::getArena().getStats();
+    ImGui::Separator();
+    ImGui::Text("Arena: %u mesh (16 bit: %u vertici, %u indici)  crescite: %u",
+        arena.meshCount, arena.quantizedMeshes, arena.shortIndexMeshes, arena.growths);
+    ImGui::Text("Vertici: %u / %u KB  Indici: %u / %u KB", arena.vertexBytes / 1024, arena.vertexByteCapacity / 1024,
+        arena.indexBytes / 1024, arena.indexByteCapacity / 1024);
+}
+
+/**
+ * @brief Mostra, per ogni pool, oggetti in uso, picco, capacità e crescite.
+ *
+ * Se il numero di blocchi aumenta durante il gioco la capacità iniziale è
+ * sottodimensionata: ogni blocco aggiuntivo è un'allocazione.
+ */
+void ImGuiManager::drawPoolSection(Engine* engine) {
+    Scene* scene = engine->getScene();
+    if (!scene || !ImGui::CollapsingHeader("Object Pool")) return;
+
+    if (ImGui::BeginTable("PoolStats", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Pool");
+        ImGui::TableSetupColumn("In uso");
+        ImGui::TableSetupColumn("Picco");
+        ImGui::TableSetupColumn("Capacita'");
+        ImGui::TableSetupColumn("Blocchi");
+        ImGui::TableSetupColumn("Acquire");
+        ImGui::TableHeadersRow();
+
+        const std::pair<const char*, const ObjectPoolStats*> pools[] = {
+            { "Proiettili", &scene->getProjectilePoolStats() },
+            { "Ostacoli", &scene->getObstaclePoolStats() }
+        };
+        for (const auto& pool : pools) {
+            const ObjectPoolStats& s = *pool.second;
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::Text("%s", pool.first);
+            ImGui::TableNextColumn(); ImGui::Text("%zu", s.inUse);
+            ImGui::TableNextColumn(); ImGui::Text("%zu", s.peakInUse);
+            ImGui::TableNextColumn(); ImGui::Text("%zu", s.capacity);
+            ImGui::TableNextColumn(); ImGui::Text("%zu", s.chunkCount);
+            ImGui::TableNextColumn(); ImGui::Text("%zu", s.acquireCount);
+        }
+        ImGui::EndTable();
+    }
+}
+
+/**
+ * @brief Disegna i comandi per lanciare i benchmark e la tabella dei risultati.
+ *
+ * I benchmark girano in modo sincrono: il frame in cui viene premuto il
+ * pulsante dura quanto la misura.
+ */
+void ImGuiManager::drawBenchmarkSection(Engine* engine) {
+    if (!ImGui::CollapsingHeader("Benchmark")) return;
+
+    if (ImGui::Button("Broadphase (1k - 50k entita')"))
+        broadphaseResults = SceneBenchmark::runBroadphase();
+    ImGui::SameLine();
+    if (ImGui::Button("Update parallelo (100k ostacoli)"))
+        parallelUpdateResults = SceneBenchmark::runParallelUpdate({ 1, 2, 4, 8, 16 }, 100000, engine->getAsteroidMeshId());
+
+    ImGui::Text("Worker JobSystem: %u", JobSystem::getWorkerCount());
+
+    if (!parallelUpdateResults.empty() &&
+        ImGui::BeginTable("ParallelUpdateResults", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Thread");
+        ImGui::TableSetupColumn("Update (ms)");
+        ImGui::TableSetupColumn("Speedup");
+        ImGui::TableHeadersRow();
+
+        for (const auto& r : parallelUpdateResults) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::Text("%u", r.threadCount);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", r.updateMs);
+            ImGui::TableNextColumn(); ImGui::Text("%.2fx", r.speedup);
+        }
+        ImGui::EndTable();
+    }
+
+    if (broadphaseResults.empty()) return;
+
+    if (ImGui::BeginTable("BroadphaseResults", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Entita'");
+        ImGui::TableSetupColumn("Griglia (ms)");
+        ImGui::TableSetupColumn("ns/entita'");
+        ImGui::TableSetupColumn("O(PxO) (ms)");
+        ImGui::TableSetupColumn("Coppie");
+        ImGui::TableHeadersRow();
+
+        for (const auto& r : broadphaseResults) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::Text("%d", r.entityCount);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", r.gridMs);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", r.gridMs * 1.0e6 / r.entityCount);
+            ImGui::TableNextColumn();
+            if (r.bruteForceMs >= 0.0) ImGui::Text("%.3f", r.bruteForceMs);
+            else ImGui::TextDisabled("-");
+            ImGui::TableNextColumn(); ImGui::Text("%d", r.collidingPairs);
+        }
+        ImGui::EndTable();
+    }
+}